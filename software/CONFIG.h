@@ -19,10 +19,12 @@
 
 #include <SPIFFS.h>
 #include <vector>
+#include <memory>
 #include <mbedtls/base64.h>
 #include <ArduinoJson.h>
 
 #include "HW.h"
+#include "TIMELINE.h"
 
 // -----------------------------------------------------------------------
 // MQTT / PointPerfect settings 
@@ -40,6 +42,31 @@ const char THINGSTREAM_ZTPURL[]   = "https://" THINGSTREAM_SERVER THINGSTREAM_ZT
 #define    AWSTRUST_ROOTCAPATH    "/repository/AmazonRootCA1.pem"   //!< the AWS root CA path
 const char AWSTRUST_ROOTCAURL[]   = "https://" AWSTRUST_SERVER AWSTRUST_ROOTCAPATH; // full AWS root CA url
 
+/** Bundled Amazon Root CA 1 (valid until 2038), it is the same as the one served at AWSTRUST_ROOTCAURL 
+ *  and allows to skip the download during provisioning, set to "" to download it instead.  
+ */
+const char AWSTRUST_ROOTCA[] = 
+  "-----BEGIN CERTIFICATE-----\n"
+  "MIIDQTCCAimgAwIBAgITBmyfz5m/jAo54vB4ikPmljZbyjANBgkqhkiG9w0BAQsF\n"
+  "ADA5MQswCQYDVQQGEwJVUzEPMA0GA1UEChMGQW1hem9uMRkwFwYDVQQDExBBbWF6\n"
+  "b24gUm9vdCBDQSAxMB4XDTE1MDUyNjAwMDAwMFoXDTM4MDExNzAwMDAwMFowOTEL\n"
+  "MAkGA1UEBhMCVVMxDzANBgNVBAoTBkFtYXpvbjEZMBcGA1UEAxMQQW1hem9uIFJv\n"
+  "b3QgQ0EgMTCCASIwDQYJKoZIhvcNAQEBBQADggEPADCCAQoCggEBALJ4gHHKeNXj\n"
+  "ca9HgFB0fW7Y14h29Jlo91ghYPl0hAEvrAIthtOgQ3pOsqTQNroBvo3bSMgHFzZM\n"
+  "9O6II8c+6zf1tRn4SWiw3te5djgdYZ6k/oI2peVKVuRF4fn9tBb6dNqcmzU5L/qw\n"
+  "IFAGbHrQgLKm+a/sRxmPUDgH3KKHOVj4utWp+UhnMJbulHheb4mjUcAwhmahRWa6\n"
+  "VOujw5H5SNz/0egwLX0tdHA114gk957EWW67c4cX8jJGKLhD+rcdqsq08p8kDi1L\n"
+  "93FcXmn/6pUCyziKrlA4b9v7LWIbxcceVOF34GfID5yHI9Y/QCB/IIDEgEw+OyQm\n"
+  "jgSubJrIqg0CAwEAAaNCMEAwDwYDVR0TAQH/BAUwAwEB/zAOBgNVHQ8BAf8EBAMC\n"
+  "AYYwHQYDVR0OBBYEFIQYzIU07LwMlJQuCFmcx7IQTgoIMA0GCSqGSIb3DQEBCwUA\n"
+  "A4IBAQCY8jdaQZChGsV2USggNiMOruYou6r4lK5IpDB/G/wkjUu0yKGX9rbxenDI\n"
+  "U5PMCCjjmCXPI6T53iHTfIUJrU6adTrCC2qJeHZERxhlbI1Bjjt/msv0tadQ1wUs\n"
+  "N+gDS63pYaACbvXy8MWy7Vu33PqUXHeeE6V/Uq2V8viTO96LXFvKWlJbYK8U90vv\n"
+  "o/ufQJVtMVT8QtPHRh8jrdkPSHCa2XV4cdFyQzR1bldZwgJcJmApzyMZFo6IQ6XU\n"
+  "5MsI+yMRQ+hDKXJioaldXgjUkK642M4UwtBV8ob2xJNDd2ZhwLnoQdeXeGADbkpy\n"
+  "rqXRfboQnoZsG4q5WTP468SQvvG5\n"
+  "-----END CERTIFICATE-----\n";
+
 /** this table defines the recional coverage (by a bounding box and its region tag and frequency
  *  the lower the higher the priority and more targeted the lat/lon region should be
  *  PointPerfect LBAND satellite augmentation service EU / US LBAND frequencies taken from: 
@@ -57,6 +84,13 @@ struct { const char* region; short lon1; short lon2; short lat1; short lat2; lon
   { "sa",   34,   56,  15, 33,          0 }, // Saudi Arabia
   { "br",  -73,  -34, -34,  3,          0 }  // Brazil
 };
+const int POINTPERFECT_REGIONS_NUM        = sizeof(POINTPERFECT_REGIONS)/sizeof(*POINTPERFECT_REGIONS); //!< number of regions
+
+const int POINTPERFECT_GRID_DEG           =                10;  //!< size of a grid cell in degrees used to speedup the region lookup
+const int POINTPERFECT_GRID_ROWS          = 180 / POINTPERFECT_GRID_DEG;  //!< number of grid rows (latitude)
+const int POINTPERFECT_GRID_COLS          = 360 / POINTPERFECT_GRID_DEG;  //!< number of grid columns (longitude)
+const uint16_t POINTPERFECT_GRID_PARTIAL  =            0x8000;  //!< flag in a grid cell, a region covers only part of the cell 
+const double POINTPERFECT_HYSTERESIS_KM   =               5.0;  //!< a region is only entered or left once the position is this far inside or outside its border
 
 const unsigned short MQTT_BROKER_PORT     =              8883;  //!< MQTTS port
 const int MQTT_MAX_MSG_SIZE               =            9*1024;  //!< the max size of a MQTT pointperfect topic
@@ -99,7 +133,9 @@ const bool NTRIP_USE_HTTP10               =             false;  //!< HTTP protoc
 #define    CONFIG_DEVICE_TITLE                 "HPG solution"   //!< a used friendly name
 #define    CONFIG_DEVICE_NAMEPREFIX                     "hpg"   //!< a hostname compatible prefix, only a-z, 0-9 and -
 
-const char CONFIG_FFS_FILE[]              =     "/config.ffs";  //!< the file in the FFS where we store the config json
+const char CONFIG_FFS_FILE[]              =     "/config.ffs";  //!< the file in the FFS where we store the config json snapshot
+const char CONFIG_FFS_JOURNAL[]           =     "/config.jnl";  //!< the journal with the changes since the last snapshot
+const char CONFIG_FFS_TEMP[]              =     "/config.tmp";  //!< the temporary snapshot written during compaction
 
 #define CONFIG_VALUE_HARDWAREID                  "hardwareId" 
 
@@ -129,18 +165,95 @@ const char CONFIG_VALUE_KEY[]             =           "ppKey";  //!< config key
 #define CONFIG_VALUE_LTEAPN                          "LteApn"   //!< config key for modem APN
 #define CONFIG_VALUE_SIMPIN                          "simPin"   //!< config key for SIM PIN
 #define CONFIG_VALUE_MNOPROF                     "mnoProfile"   //!< config key for modem MNO profile
+const char CONFIG_VALUE_LTECERTS[]        =        "lteCerts";  //!< config key for fingerprint of the credentials imported to the modem (temprorary)
+const char CONFIG_VALUE_LTEBAUD[]         =         "lteBaud";  //!< config key for best verified modem baudrate, format: <module>:<baudrate> (temprorary)
+
+const int CONFIG_MAX_SUBSCRIBERS          =                 4;  //!< max number of tasks that can subscribe to configuration changes
+const char CONFIG_FFS_BLOB_FORMAT[]       =      "/%s.ffs";  //!< the file in the FFS where we store a bulky value (certificates), %s is the key name
+const char CONFIG_FFS_BLOB_TEMP[]         =      "/%s.tmp";  //!< the temporary file written before it replaces the blob, %s is the key name
+const int CONFIG_STORE_SIZE               =               832;  //!< capacity of the fixed storage, must hold the sum of all key sizes
+const int CONFIG_SAVE_DELAY               =              2000;  //!< changes are coalesced during this time before they are written to the journal
+const int CONFIG_JOURNAL_MAX              =              4096;  //!< compact the journal into a new snapshot when it grows beyond this size
+const uint8_t CONFIG_JOURNAL_TAG          =              0xA5;  //!< start of a journal record
+
+const char* CONFIG_TASK_NAME              =          "Config";  //!< Config task name
+const int CONFIG_STACK_SIZE               =          3*1024;  //!< Config task stack size
+const int CONFIG_TASK_PRIO                =                 1;  //!< Config task priority
+const int CONFIG_TASK_CORE                =                 1;  //!< Config task MCU code
                           
-/** This class encapsulates all WLAN functions. 
+extern class CONFIG Config; //!< Forward declaration of class
+
+/** This class encapsulates all configuration functions. 
 */
 class CONFIG {
   
 public:
 
+  //! key groups, a change of a key increments the generation counter of its group and notifies the subscribers
+  typedef enum { 
+    GROUP_SOURCE  = 1<<0,   //!< the correction source selection
+    GROUP_REGION  = 1<<1,   //!< the region and LBAND frequency depending on location 
+    GROUP_MQTT    = 1<<2,   //!< the PointPerfect credentials, ZTP token and stream 
+    GROUP_NTRIP   = 1<<3,   //!< the NTRIP server and credentials
+    GROUP_NUM     = 4       //!< number of groups
+  } GROUP;
+
+  //! compile time ids of all configuration keys, must be aligned with KEY_LUT
+  typedef enum { 
+    KEY_CLIENTID = 0, 
+    KEY_ZTPTOKEN, 
+    KEY_STREAM, 
+    KEY_BROKERHOST, 
+    KEY_ROOTCA, 
+    KEY_CLIENTCERT, 
+    KEY_CLIENTKEY, 
+    KEY_NTRIP_SERVER, 
+    KEY_NTRIP_USERNAME, 
+    KEY_NTRIP_PASSWORD, 
+    KEY_NTRIP_VERSION, 
+    KEY_NTRIP_GGA, 
+    KEY_REGION, 
+    KEY_FREQ, 
+    KEY_PPKEY, 
+    KEY_USESOURCE, 
+    KEY_LTEAPN, 
+    KEY_SIMPIN, 
+    KEY_MNOPROF, 
+    KEY_LTECERTS, 
+    KEY_LTEBAUD, 
+    KEY_NUM 
+  } KEY;
+
+  //! the storage type of a key
+  typedef enum { 
+    TYPE_STRING = 0,        //!< a string kept in fixed-capacity storage
+    TYPE_LONG,              //!< a number kept in fixed-capacity storage
+    TYPE_BLOB               //!< a bulky string kept in a separate file and loaded on demand
+  } TYPE;
+
   /** constructor
    */
   CONFIG() {
     mutex = xSemaphoreCreateMutex();
     ffsOk = false;
+    for (int i = 0; i < GROUP_NUM; i ++) {
+      generation[i] = 0;
+    }
+    memset(subscribers, 0, sizeof(subscribers));
+    topicSetGeneration = 0;
+    dirty = 0;
+    savePending = false;
+    compactPending = false;
+    saveTask = NULL;
+    // layout of the fixed-capacity storage 
+    size_t offset = 0;
+    for (int i = 0; i < KEY_NUM; i ++) {
+      offsets[i] = offset;
+      offset += KEY_LUT[i].size;
+    }
+    configASSERT(offset <= sizeof(store));
+    gridInit();
+    memset(store, 0, sizeof(store));
     // create a unique name from the mac 
     uint64_t mac = ESP.getEfuseMac();
     const char* p = (const char*)&mac;
@@ -149,8 +262,7 @@ public:
     title = str;
     sprintf(str, CONFIG_DEVICE_NAMEPREFIX "-%02x%02x%02x", p[3], p[4], p[5]);
     name = str;
-    wlanReconnect = false;
-    lteReconnect = false;
+    esp_register_shutdown_handler(onShutdown);
   }
 
   /** get a name of the device
@@ -167,148 +279,289 @@ public:
     return title; 
   } 
   
-  /** init the file system
+  /** init the file system, read the configuration and spin off the task that persists changes
    *  \return  true if file system and config file is ready 
    */
   bool init(void) {
     bool cfgOk = false;
+    int32_t start = millis();
+    int heap = ESP.getFreeHeap();
     if (ffsInit()) {
       log_i("FFS ok");
+      Timeline.mark(TIMELINE::FFS);
       cfgOk = read();
+      Timeline.mark(TIMELINE::CONFIG);
       if (cfgOk) {
-        log_i("file \"FFS%s\" read", CONFIG_FFS_FILE);
+        log_i("file \"FFS%s\" read in %d ms, heap used %d", CONFIG_FFS_FILE, millis() - start, heap - ESP.getFreeHeap());
       } 
     } else {
       log_e("FFS failed");
     }
+    xTaskCreatePinnedToCore(task, CONFIG_TASK_NAME, CONFIG_STACK_SIZE, this, CONFIG_TASK_PRIO, &saveTask, CONFIG_TASK_CORE);
     return cfgOk;
   }
 
-  /** delete the configuration file from the file system  
+  /** delete the configuration file and the blob files from the file system  
    */
   void reset(void) {
     if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
       if (ffsOk) {
-        if (SPIFFS.exists(CONFIG_FFS_FILE)) {
-          SPIFFS.remove(CONFIG_FFS_FILE);
+        const char* files[] = { CONFIG_FFS_FILE, CONFIG_FFS_JOURNAL, CONFIG_FFS_TEMP };
+        for (int i = 0; i < sizeof(files)/sizeof(*files); i ++) {
+          if (SPIFFS.exists(files[i])) {
+            SPIFFS.remove(files[i]);
+          }
+        }
+        for (int i = 0; i < KEY_NUM; i ++) {
+          if (TYPE_BLOB == KEY_LUT[i].type) {
+            dirty &= ~(1UL << i);
+            blobs[i] = String();
+            blobWrite((KEY)i, "");
+          }
         }
       }
       xSemaphoreGive(mutex);
     }
   }
   
-  /** save the local copy to the file system  
-   *  \return  the succcess of the operation
+  /** request to save the changes, the changes are coalesced for CONFIG_SAVE_DELAY and 
+   *  then appended to the journal by the config task, so the caller is never blocked by the FFS. 
+   *  The blobs are kept in memory until the config task writes them to their own files. 
+   *  \return  true if the file system is available 
    */
   bool save(void) {
-    int len = -1;
     if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      if (ffsOk) {
-        if (SPIFFS.exists(CONFIG_FFS_FILE)) {
-          SPIFFS.remove(CONFIG_FFS_FILE);
-        }
-        File file = SPIFFS.open(CONFIG_FFS_FILE, FILE_WRITE);
-        if (file) {
-          len = serializeJson(json, file);
-          file.close();
-        }
+      if (!savePending) {
+        savePending = true;
+        ttagSave = millis() + CONFIG_SAVE_DELAY;
       }
       xSemaphoreGive(mutex);
     }
-    if (-1 == len) {
-      log_e("file \"FFS%s\" open failed", CONFIG_FFS_FILE);
-    } else if (0 == len) {
-      log_e("file \"FFS%s\" serialize and write failed", CONFIG_FFS_FILE);
-    } else {
-      log_d("file size %d", len);
+    if (NULL != saveTask) {
+      xTaskNotifyGive(saveTask);
     }
-    return (len > 0);
+    return ffsOk;
   }
 
-  /** read the config file system into the local buffer
+  /** read the snapshot from the file system into the local storage and replay the journal, blobs found  
+   *  in the snapshot (older versions) are migrated to their own files. Also recovers from a 
+   *  compaction that was interrupted. 
    *  \return  the succcess of the operation
    */
   bool read(void) {
     bool openOk = false;
+    bool migrate = false;
+    int records = 0;
     DeserializationError err = DeserializationError::EmptyInput;
     if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+      if (ffsOk && SPIFFS.exists(CONFIG_FFS_TEMP)) {
+        if (SPIFFS.exists(CONFIG_FFS_FILE)) {
+          // the temporary snapshot may be incomplete, the old snapshot and journal are still valid
+          SPIFFS.remove(CONFIG_FFS_TEMP);
+        } else {
+          // the temporary snapshot was complete, the rename did not happen
+          SPIFFS.rename(CONFIG_FFS_TEMP, CONFIG_FFS_FILE);
+          log_w("file \"FFS%s\" recovered", CONFIG_FFS_FILE);
+        }
+      }
+      if (ffsOk) {
+        for (int i = 0; i < KEY_NUM; i ++) {
+          if (TYPE_BLOB == KEY_LUT[i].type) {
+            blobRecover((KEY)i);
+          }
+        }
+      }
       if (ffsOk && SPIFFS.exists(CONFIG_FFS_FILE)) {
         File file = SPIFFS.open(CONFIG_FFS_FILE, FILE_READ);
         if (file) {
           openOk = true;
+          JsonDocument json;
           err = deserializeJson(json, file);
           file.close();
+          if (DeserializationError::Ok == err) {
+            migrate = importJson(json);
+          }
         }
       }
+      if (ffsOk && SPIFFS.exists(CONFIG_FFS_JOURNAL)) {
+        records = journalReplay();
+        if (0 > records) {
+          // a record was torn, get rid of it with a new snapshot
+          compactPending = true;
+        }
+      }
+      if (migrate) {
+        compactPending = true;
+      }
       xSemaphoreGive(mutex);
     }
     if (!openOk) {
-      log_d("file \"FFS&s\" open failed", CONFIG_FFS_FILE);
+      log_d("file \"FFS%s\" open failed", CONFIG_FFS_FILE);
     } else if (DeserializationError::Ok != err) {
       log_e("file \"FFS%s\" deserialze failed with error %d", CONFIG_FFS_FILE, err);
     } else {
       log_d("file \"FFS%s\"", CONFIG_FFS_FILE);
+      if (migrate) {
+        log_i("file \"FFS%s\" migrated", CONFIG_FFS_FILE);
+      }
+    }
+    if (0 > records) {
+      log_w("file \"FFS%s\" replayed %d records, last record corrupt", CONFIG_FFS_JOURNAL, -records - 1);
+    } else if (0 < records) {
+      log_d("file \"FFS%s\" replayed %d records", CONFIG_FFS_JOURNAL, records);
     }
-    return DeserializationError::Ok == err;
+    return (DeserializationError::Ok == err) || (0 != records);
   }
 
-  /** get the value of a config key  
+  /** find the key id from its name, used by the portal
+   *  \param key  the parameter key name    
+   *  \return     the key id or KEY_NUM if not found
+   */
+  static KEY find(const char *key) {
+    for (int i = 0; i < KEY_NUM; i ++) {
+      if (0 == strcmp(key, KEY_LUT[i].name)) {
+        return (KEY)i;
+      }
+    }
+    return KEY_NUM;
+  }
+
+  /** get the value of a config key, without any allocation, blobs are not supported 
+   *  \param key  the parameter key    
+   *  \param buf  the buffer to store the value
+   *  \param len  the size of the buffer
+   *  \return     true if the value fits into the buffer and is not empty
+   */
+  bool getValue(KEY key, char* buf, size_t len) {
+    bool ok = false;
+    if ((0 < len) && (key < KEY_NUM) && (TYPE_BLOB != KEY_LUT[key].type)) {
+      if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+        int size = toString(key, buf, len);
+        ok = (0 < size) && (size < len);
+        xSemaphoreGive(mutex);
+      }
+    }
+    if (!ok && (0 < len)) {
+      *buf = '\0';
+    }
+    return ok;
+  }
+
+  /** compare the value of a config key, without any allocation
+   *  \param key    the parameter key    
+   *  \param value  the value to compare to
+   *  \return       true if the value is equal 
+   */
+  bool equals(KEY key, const char* value) {
+    bool equal = false;
+    if ((key < KEY_NUM) && (TYPE_STRING == KEY_LUT[key].type)) {
+      if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+        equal = (0 == strcmp(&store[offsets[key]], value));
+        xSemaphoreGive(mutex);
+      }
+    }
+    return equal;
+  }
+
+  /** get the value of a config key, blobs are loaded from the file system  
    *  \param key  the parameter key    
    *  \return     the parameter value
    */
-  String getValue(const char *key) {
+  String getValue(KEY key) {
     String str;
-    if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      JsonVariantConst obj = json[key];
-      if (!obj.isNull() && obj.is<const char*>()) str = obj.as<const char*>();
-      xSemaphoreGive(mutex);
+    if (key < KEY_NUM) {
+      if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+        if (TYPE_BLOB == KEY_LUT[key].type) {
+          blobRead(key, str);
+        } else {
+          char buf[KEY_LUT[key].size + 12];
+          toString(key, buf, sizeof(buf));
+          str = buf;
+        }
+        xSemaphoreGive(mutex);
+      }
+      log_v("key %s is \"%s\"", KEY_LUT[key].name, str.c_str());
     }
-    log_v("key %s is \"%s\"", key, str.c_str());
     return str;
   }
   
+  /** get the value of a config key by name, used by the portal
+   *  \param key  the parameter key name    
+   *  \return     the parameter value
+   */
+  String getValue(const char *key) {
+    return getValue(find(key));
+  }
+  
   /** set the value of a config key 
    *  \param key    the parameter key    
    *  \param value  the parameter value
    *  \return       true if value was changed
    */
-  bool setValue(const char *key, String value) {
-    String old;
+  bool setValue(KEY key, const char* value) {
     bool changed = false;
-    if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) { 
-      JsonVariantConst obj = json[key];
-      if (!obj.isNull() && obj.is<const char*>()) old = obj.as<const char*>();
-      changed = !old.equals(value);
+    bool ok = true;
+    uint32_t groups = 0;
+    if (key >= KEY_NUM) {
+      ok = false;
+    } else if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) { 
+      if (TYPE_BLOB == KEY_LUT[key].type) {
+        // the blob is kept in memory until the config task writes it with the other changes
+        String old;
+        blobRead(key, old);
+        changed = !old.equals(value);
+        if (changed) {
+          blobs[key] = value;
+        }
+      } else {
+        ok = assign(key, value, &changed);
+      }
       if (changed) {
-        json[String(key)] = value;
+        groups = touch(key);
+        dirty |= 1UL << key;
       }
       xSemaphoreGive(mutex); 
     }
-    if (changed) {
-      log_v("key %s changed from \"%s\" to \"%s\"", key, old.c_str(), value.c_str()); 
+    if (!ok) {
+      log_e("key %s failed to set \"%s\"", (key < KEY_NUM) ? KEY_LUT[key].name : "?", value);
+    } else if (changed) {
+      notify(groups);
+      log_v("key %s changed to \"%s\"", KEY_LUT[key].name, value); 
     } else {
-      log_v("key %s keep \"%s\" as unchanged", key, old.c_str()); 
+      log_v("key %s keep \"%s\" as unchanged", KEY_LUT[key].name, value); 
     }
     return changed;
   } 
 
+  /** set the value of a config key 
+   *  \param key    the parameter key    
+   *  \param value  the parameter value
+   *  \return       true if value was changed
+   */
+  bool setValue(KEY key, const String& value) {
+    return setValue(key, value.c_str());
+  } 
+
+  /** set the value of a config key by name, used by the portal
+   *  \param key    the parameter key name   
+   *  \param value  the parameter value
+   *  \return       true if value was changed
+   */
+  bool setValue(const char *key, const String& value) {
+    KEY id = find(key);
+    if (KEY_NUM == id) {
+      log_w("key %s unknown", key);
+      return false;
+    }
+    return setValue(id, value.c_str());
+  } 
+
   /** delete the value of a config key 
    *  \param key    the parameter key    
    *  \return       true if changed, key was removed
    */
-  bool delValue(const char *key) {
-    bool changed = false;
-    if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      changed = !json[key].isNull();
-      if (changed) {
-        json.remove(key);
-      }
-      xSemaphoreGive(mutex); 
-    }
-    if (changed) {
-      log_v("key %s", key);
-    }
-    return changed;
+  bool delValue(KEY key) {
+    return setValue(key, (TYPE_LONG == KEY_LUT[key].type) ? "0" : "");
   }
 
   /** set the value of a config key 
@@ -317,13 +570,13 @@ public:
    *  \param len     the length of the output buffer
    *  \return        true if value was changed
    */
-  bool setValue(const char *key, const uint8_t* buffer, size_t len) {
+  bool setValue(KEY key, const uint8_t* buffer, size_t len) {
     bool changed = false;
     size_t encLen = 0;
     mbedtls_base64_encode(NULL, 0, &encLen, buffer, len);
     uint8_t encBuf[encLen];
     if (0 == mbedtls_base64_encode(encBuf, sizeof(encBuf), &encLen, buffer, len)) {
-      changed = setValue(key, String((const char*)encBuf)); 
+      changed = setValue(key, (const char*)encBuf); 
     } 
     return changed;
   }
@@ -334,56 +587,76 @@ public:
    *  \param len     the length of the output buffer
    *  \return        the length actualy put in the buffer
    */
-  int getValue(const char *key, uint8_t* buffer, size_t len) {
-    String string = getValue(key);
+  int getValue(KEY key, uint8_t* buffer, size_t len) {
+    char string[KEY_LUT[key].size];
     size_t decLen = 0;
-    if (0 == mbedtls_base64_decode(buffer, len, &decLen, (const unsigned char *)string.c_str(), string.length())) {
-      if (decLen > len)
+    if (getValue(key, string, sizeof(string))) {
+      if (0 == mbedtls_base64_decode(buffer, len, &decLen, (const unsigned char *)string, strlen(string))) {
+        if (decLen > len)
+          decLen = 0;
+      } else {
         decLen = 0;
-    } else {
-      decLen = 0;
+      }
     }
     return decLen;
   }
   
-  /** get the topics to subscribe  
-   *  \return  a vector with all the topics
+  /** get the generation of the topic set, it changes whenever the stream or region changes
+   *  \return  the generation 
    */
-  std::vector<String> getTopics(void)
+  uint32_t getTopicsGeneration(void) {
+    return getGeneration(GROUP_MQTT | GROUP_REGION);
+  }
+
+  /** get the topics to subscribe, the set is shared by all clients and only rebuilt when the 
+   *  stream or region changed. 
+   *  \param generation  optional, returns the generation of the set, see getTopicsGeneration
+   *  \return            the set with all the topics
+   */
+  std::shared_ptr<const std::vector<String>> getTopics(uint32_t* generation = NULL)
   { 
-    String stream;
-    String region;
-    String source;
+    std::shared_ptr<const std::vector<String>> set;
+    uint32_t gen = getTopicsGeneration();
     if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      JsonVariantConst obj = json[CONFIG_VALUE_STREAM];
-      if (!obj.isNull() && obj.is<const char*>()) stream = obj.as<const char*>();
-      obj = json[CONFIG_VALUE_REGION];
-      region = (!obj.isNull() && obj.is<const char*>()) ? obj.as<const char*>() : POINTPERFECT_REGIONS[0].region;
-      obj = json[CONFIG_VALUE_USESOURCE];
-      if (!obj.isNull() && obj.is<const char*>()) source = obj.as<const char*>();
+      if (!topicSet || (topicSetGeneration != gen)) {
+        const char* stream = &store[offsets[KEY_STREAM]];
+        const char* region = &store[offsets[KEY_REGION]];
+        if (!*region) {
+          region = POINTPERFECT_REGIONS[0].region;
+        }
+        std::vector<String>* topics = new std::vector<String>();
+        topics->push_back(MQTT_TOPIC_MGA);
+        //topics->push_back(MQTT_TOPIC_MGA_GPS);
+        //topics->push_back(MQTT_TOPIC_MGA_GLO);
+        //topics->push_back(MQTT_TOPIC_MGA_GAL);
+        //topics->push_back(MQTT_TOPIC_MGA_BDS);
+        if (*stream) {
+          topics->push_back(String(MQTT_TOPIC_KEY_FORMAT) + stream);
+          if (0 == strcmp(stream, MQTT_STREAM_LBAND)) {
+            topics->push_back(MQTT_TOPIC_FREQ);
+          }
+          if (*region) {
+            String prefix = String(MQTT_TOPIC_IP_FORMAT) + stream + "/" + region;
+            //topics->push_back(prefix);
+            // subscribe individually to subtopics, as this should speedup time to first fix
+            topics->push_back(prefix + MQTT_TOPIC_IP_GAD);
+            topics->push_back(prefix + MQTT_TOPIC_IP_HPAC);
+            topics->push_back(prefix + MQTT_TOPIC_IP_OCB);
+            topics->push_back(prefix + MQTT_TOPIC_IP_CLK);
+          }
+        }
+        topicSet.reset(topics);
+        topicSetGeneration = gen;
+        log_d("topic set rebuilt with %d topics, generation %u", topics->size(), gen);
+      }
+      set = topicSet;
+      gen = topicSetGeneration;
       xSemaphoreGive(mutex); 
     }
-    std::vector<String> topics;
-    topics.push_back(MQTT_TOPIC_MGA);
-    //topics.push_back(MQTT_TOPIC_MGA_GPS);
-    //topics.push_back(MQTT_TOPIC_MGA_GLO);
-    //topics.push_back(MQTT_TOPIC_MGA_GAL);
-    //topics.push_back(MQTT_TOPIC_MGA_BDS);
-    if (0 < stream.length()) {
-      topics.push_back(MQTT_TOPIC_KEY_FORMAT + stream);
-      if (stream.equals(MQTT_STREAM_LBAND)) {
-        topics.push_back(MQTT_TOPIC_FREQ);
-      }
-      if (0 < region.length()) {
-        //topics.push_back(MQTT_TOPIC_IP_FORMAT + stream + "/" + region);
-        // subscribe individually to subtopics, as this should speedup time to first fix
-        topics.push_back(MQTT_TOPIC_IP_FORMAT + stream + "/" + region + MQTT_TOPIC_IP_GAD);
-        topics.push_back(MQTT_TOPIC_IP_FORMAT + stream + "/" + region + MQTT_TOPIC_IP_HPAC);
-        topics.push_back(MQTT_TOPIC_IP_FORMAT + stream + "/" + region + MQTT_TOPIC_IP_OCB);
-        topics.push_back(MQTT_TOPIC_IP_FORMAT + stream + "/" + region + MQTT_TOPIC_IP_CLK);
-      }
+    if (generation) {
+      *generation = gen;
     }
-    return topics;
+    return set;
   }
   
   /** get the LBAND frequency  
@@ -392,11 +665,10 @@ public:
   long getFreq(void) {
     long freq = 0;
     if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      JsonVariantConst obj = json[CONFIG_VALUE_FREQ];
-      freq = (!obj.isNull() && obj.is<long>()) ? obj.as<long>() : POINTPERFECT_REGIONS[0].freq;
+      freq = getLong(KEY_FREQ);
       xSemaphoreGive(mutex); 
     }
-    return freq;
+    return freq ? freq : POINTPERFECT_REGIONS[0].freq;
   }
   
   /** extract the lband freuqencies for all supported regions from the json buffer 
@@ -417,9 +689,17 @@ public:
             obj = obj["current"]["value"];
             if (!obj.isNull() && obj.is<double>()) {
               long freq = (long)(1e6 * obj.as<double>());
-              if (POINTPERFECT_REGIONS[i].freq != freq) {
-                log_w("region %s update freq to %li from %li", region, freq, POINTPERFECT_REGIONS[i].freq);
-                POINTPERFECT_REGIONS[i].freq = freq; 
+              long oldFreq = 0;
+              if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+                oldFreq = POINTPERFECT_REGIONS[i].freq;
+                if (oldFreq != freq) {
+                  POINTPERFECT_REGIONS[i].freq = freq; 
+                  gridCell = -1; // force a full lookup on the next location update
+                }
+                xSemaphoreGive(mutex); 
+              }
+              if (oldFreq != freq) {
+                log_w("region %s update freq to %li from %li", region, freq, oldFreq);
               }
             }
           }
@@ -428,50 +708,79 @@ public:
     }
   }
 
-  /** set current location, this will set the region and LBAND frequency
+  /** set current location, this will set the region and LBAND frequency, the store is only 
+   *  touched if any of the two changes. 
    *  \param lat  the current latitude
    *  \param lon  the current longitude
    */
-  void updateLocation(int lat, int lon) {
-    // the highest entries have highest priority
-    long freq = 0;
-    const char* region = NULL;
-    for (int i = 0; i < sizeof(POINTPERFECT_REGIONS)/sizeof(*POINTPERFECT_REGIONS); i ++) {
-      if ((lat >= POINTPERFECT_REGIONS[i].lat1 && lat <= POINTPERFECT_REGIONS[i].lat2) &&
-          (lon >= POINTPERFECT_REGIONS[i].lon1 && lon <= POINTPERFECT_REGIONS[i].lon2)) {
-        if (POINTPERFECT_REGIONS[i].freq) {
-          freq = POINTPERFECT_REGIONS[i].freq;
-        }
-        if (POINTPERFECT_REGIONS[i].region) {
-          region = POINTPERFECT_REGIONS[i].region;
-        }
-      }
-    } 
+  void updateLocation(double lat, double lon) {
+    int row = (int)floor((lat + 90.0) / POINTPERFECT_GRID_DEG);
+    int col = (int)floor((lon + 180.0) / POINTPERFECT_GRID_DEG);
+    row = (row < 0) ? 0 : (row >= POINTPERFECT_GRID_ROWS) ? POINTPERFECT_GRID_ROWS - 1 : row;
+    col = (col < 0) ? 0 : (col >= POINTPERFECT_GRID_COLS) ? POINTPERFECT_GRID_COLS - 1 : col;
+    int cell = row * POINTPERFECT_GRID_COLS + col;
     bool changed = false;
+    const char* region = NULL;
+    long freq = 0;
+    // the selection state is shared with setLbandFreqs() called from other tasks
     if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      JsonVariantConst obj = json[CONFIG_VALUE_REGION];
-      if (region) {
-        String oldRegion;
-        if (!obj.isNull() && obj.is<const char*>()) oldRegion = obj.as<const char*>();
-        if (!oldRegion.equals(region)) {
-          json[CONFIG_VALUE_REGION] = region;
-          changed = true;
+      // fast path, we are still in a cell that is fully covered by the regions we already selected
+      if (cell != gridCell) {
+        // only check the regions that overlap this cell, the highest entries have highest priority
+        uint16_t mask = grid[cell];
+        int newRegion = -1;
+        int newFreq = -1;
+        for (int i = 0; i < POINTPERFECT_REGIONS_NUM; i ++) {
+          if ((mask & (1 << i)) && inRegion(i, lat, lon, 0.0)) {
+            if (POINTPERFECT_REGIONS[i].freq) {
+              newFreq = i;
+            }
+            if (POINTPERFECT_REGIONS[i].region) {
+              newRegion = i;
+            }
+          }
+        } 
+        // apply the hysteresis, but accept anything on the first fix
+        bool settled = true;
+        if (regionIdx >= -1) {
+          int idx = hysteresis(regionIdx, newRegion, lat, lon);
+          settled = settled && (idx == newRegion);
+          newRegion = idx;
+          idx = hysteresis(freqIdx, newFreq, lat, lon);
+          settled = settled && (idx == newFreq);
+          newFreq = idx;
         }
-      } else if (!obj.isNull()) { // we leave coverage area
-        json.remove(CONFIG_VALUE_REGION);
-        changed = true;
-      }
-      if (freq) {
-        JsonVariantConst obj = json[CONFIG_VALUE_FREQ];
-        long oldFreq = (!obj.isNull() && obj.is<long>())  ? obj.as<long>() : 0;
-        if (freq != oldFreq) {
-            json[CONFIG_VALUE_FREQ] = freq;
+        gridCell = (settled && !(mask & POINTPERFECT_GRID_PARTIAL)) ? cell : -1;
+        region = (newRegion >= 0) ? POINTPERFECT_REGIONS[newRegion].region : NULL;
+        freq = (newFreq >= 0) ? POINTPERFECT_REGIONS[newFreq].freq : 0;
+        if ((newRegion != regionIdx) || (newFreq != freqIdx) || (freq != curFreq)) {
+          regionIdx = newRegion;
+          freqIdx = newFreq;
+          curFreq = freq;
+          char* oldRegion = &store[offsets[KEY_REGION]];
+          if (region) {
+            if (0 != strcmp(oldRegion, region)) {
+              strncpy(oldRegion, region, KEY_LUT[KEY_REGION].size - 1);
+              changed = true;
+            }
+          } else if (*oldRegion) { // we leave coverage area
+            *oldRegion = '\0';
             changed = true;
+          }
+          if (freq && (freq != getLong(KEY_FREQ))) {
+            setLong(KEY_FREQ, freq);
+            changed = true;
+          }
+          if (changed) {
+            touch(KEY_REGION);
+            dirty |= (1UL << KEY_REGION) | (1UL << KEY_FREQ);
+          }
         }
       }
       xSemaphoreGive(mutex); 
     }
     if (changed) {
+      notify(GROUP_REGION);
       log_i("region \"%s\" freq %d", region ? region : "", freq);
       save();
     }
@@ -480,14 +789,9 @@ public:
   /** delete the zero touch provisioning credentials
    */
   void delZtp(void) {
-    if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      json.remove(CONFIG_VALUE_BROKERHOST);
-      json.remove(CONFIG_VALUE_STREAM);
-      json.remove(CONFIG_VALUE_ROOTCA);
-      json.remove(CONFIG_VALUE_CLIENTCERT);
-      json.remove(CONFIG_VALUE_CLIENTKEY);
-      json.remove(CONFIG_VALUE_CLIENTID);
-      xSemaphoreGive(mutex); 
+    const KEY keys[] = { KEY_BROKERHOST, KEY_STREAM, KEY_ROOTCA, KEY_CLIENTCERT, KEY_CLIENTKEY, KEY_CLIENTID };
+    for (int i = 0; i < sizeof(keys)/sizeof(*keys); i ++) {
+      delValue(keys[i]);
     }
     log_i("ZTP deleted");
   }
@@ -517,15 +821,12 @@ public:
       bool lband = jsonZtp["supportsLband"];
       if (cert.length() && key.length() && id.length() && broker.length() && rootCa.length()) {
         log_i("ZTP complete clientId is \"%s\"", id.c_str());
-        if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-          json[CONFIG_VALUE_BROKERHOST] = broker;
-          json[CONFIG_VALUE_STREAM]     = lband ? MQTT_STREAM_LBAND : MQTT_STREAM_IP;
-          json[CONFIG_VALUE_ROOTCA]     = rootCa;
-          json[CONFIG_VALUE_CLIENTCERT] = cert;
-          json[CONFIG_VALUE_CLIENTKEY]  = key;
-          json[CONFIG_VALUE_CLIENTID]   = id;
-          xSemaphoreGive(mutex); 
-        }
+        setValue(KEY_BROKERHOST, broker);
+        setValue(KEY_STREAM,     lband ? MQTT_STREAM_LBAND : MQTT_STREAM_IP);
+        setValue(KEY_ROOTCA,     rootCa);
+        setValue(KEY_CLIENTCERT, cert);
+        setValue(KEY_CLIENTKEY,  key);
+        setValue(KEY_CLIENTID,   id);
         save();
       } else {
         log_e("some json fields missing");
@@ -538,17 +839,12 @@ public:
    *  \return  the ZTP request string to POST
    */
   String ztpRequest(void) {
-    String token;
-    if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      JsonVariantConst obj = json[CONFIG_VALUE_ZTPTOKEN];
-      if (!obj.isNull() && obj.is<const char*>()) token = obj.as<const char*>();
-      xSemaphoreGive(mutex); 
-    }
+    char token[KEY_LUT[KEY_ZTPTOKEN].size];
     String str;
-    if (token.length()) {
+    if (getValue(KEY_ZTPTOKEN, token, sizeof(token))) {
       JsonDocument json;
       json["tags"][0] = "ztp";
-      json["token"]   = token.c_str();
+      json["token"]   = (const char*)token;
       json["hardwareId"] = getDeviceName();
       json["givenName"] = getDeviceTitle();
       if (0 < serializeJson(json,str)) {
@@ -558,10 +854,550 @@ public:
     return str;
   }
  
-  bool wlanReconnect; //!< a change in configuration happened, this is used to notify WLAN FSM
-  bool lteReconnect;  //!< a change in configuration happened, this is used to notify LTE FSM
+  /** subscribe a task to changes of key groups, the task is woken with a task notification 
+   *  and should then compare the generation of the groups it is interested in.
+   *  \param task    the task handle to notify, NULL for the calling task
+   *  \param groups  the mask of GROUP values of interest 
+   *  \return        true if the subscription was added
+   */
+  bool subscribe(TaskHandle_t task, uint32_t groups) {
+    bool ok = false;
+    if (NULL == task) {
+      task = xTaskGetCurrentTaskHandle();
+    }
+    if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+      for (int i = 0; !ok && (i < CONFIG_MAX_SUBSCRIBERS); i ++) {
+        if ((NULL == subscribers[i].task) || (task == subscribers[i].task)) {
+          subscribers[i].task = task;
+          subscribers[i].groups = groups;
+          ok = true;
+        }
+      }
+      xSemaphoreGive(mutex); 
+    }
+    if (!ok) {
+      log_e("too many subscribers");
+    }
+    return ok;
+  }
+
+  /** get the generation of a set of key groups, the value changes whenever a key in any of 
+   *  the groups is changed, this can be called without taking the mutex.
+   *  \param groups  the mask of GROUP values
+   *  \return        the combined generation counter
+   */
+  uint32_t getGeneration(uint32_t groups) {
+    uint32_t sum = 0;
+    for (int i = 0; i < GROUP_NUM; i ++) {
+      if (groups & (1 << i)) {
+        sum += generation[i];
+      }
+    }
+    return sum;
+  }
 
 protected:
+
+  //! the description of a key in the registry 
+  typedef struct { 
+    const char* name;     //!< the key name used in the JSON file and by the portal
+    TYPE type;            //!< the storage type
+    uint32_t group;       //!< the group of the key, 0 if changes are not notified
+    uint16_t size;        //!< the storage capacity in bytes, including the terminating zero for strings
+  } KEYINFO;
+  static const KEYINFO KEY_LUT[KEY_NUM]; //!< the registry of all keys, must be aligned with KEY 
+
+  /** build the grid used by updateLocation, each cell holds a mask of the regions that overlap it 
+   *  and a flag if any of them covers only part of the cell. 
+   */
+  void gridInit(void) {
+    configASSERT(POINTPERFECT_REGIONS_NUM < 15);
+    for (int row = 0; row < POINTPERFECT_GRID_ROWS; row ++) {
+      int lat1 = row * POINTPERFECT_GRID_DEG - 90;
+      int lat2 = lat1 + POINTPERFECT_GRID_DEG;
+      for (int col = 0; col < POINTPERFECT_GRID_COLS; col ++) {
+        int lon1 = col * POINTPERFECT_GRID_DEG - 180;
+        int lon2 = lon1 + POINTPERFECT_GRID_DEG;
+        uint16_t mask = 0;
+        for (int i = 0; i < POINTPERFECT_REGIONS_NUM; i ++) {
+          if ((POINTPERFECT_REGIONS[i].lat1 <= lat2) && (POINTPERFECT_REGIONS[i].lat2 >= lat1) && 
+              (POINTPERFECT_REGIONS[i].lon1 <= lon2) && (POINTPERFECT_REGIONS[i].lon2 >= lon1)) {
+            mask |= 1 << i;
+            if ((POINTPERFECT_REGIONS[i].lat1 > lat1) || (POINTPERFECT_REGIONS[i].lat2 < lat2) || 
+                (POINTPERFECT_REGIONS[i].lon1 > lon1) || (POINTPERFECT_REGIONS[i].lon2 < lon2)) {
+              mask |= POINTPERFECT_GRID_PARTIAL;
+            }
+          }
+        }
+        grid[row * POINTPERFECT_GRID_COLS + col] = mask;
+      }
+    }
+    gridCell = -1;
+    regionIdx = -2; // unknown, no hysteresis on first fix
+    freqIdx = -2;
+    curFreq = 0;
+  }
+
+  /** check if a position is within the box of a region 
+   *  \param idx     the index into POINTPERFECT_REGIONS
+   *  \param lat     the latitude
+   *  \param lon     the longitude
+   *  \param margin  the distance in km by which the box is grown, or shrunk if negative
+   *  \return        true if inside
+   */
+  static bool inRegion(int idx, double lat, double lon, double margin) {
+    double dLat = margin / 111.2; // km per degree latitude
+    double cosLat = cos(lat * M_PI / 180.0);
+    double dLon = dLat / ((cosLat > 0.01) ? cosLat : 0.01);
+    return (lat >= POINTPERFECT_REGIONS[idx].lat1 - dLat) && (lat <= POINTPERFECT_REGIONS[idx].lat2 + dLat) &&
+           (lon >= POINTPERFECT_REGIONS[idx].lon1 - dLon) && (lon <= POINTPERFECT_REGIONS[idx].lon2 + dLon);
+  }
+
+  /** decide if we change from the current to a new region, we stay in the current region while we are 
+   *  close to its border and only enter a new region once we are well inside. 
+   *  \param cur     the current index into POINTPERFECT_REGIONS, -1 if none
+   *  \param idx     the new index into POINTPERFECT_REGIONS, -1 if none
+   *  \param lat     the latitude
+   *  \param lon     the longitude
+   *  \return        the index to use
+   */
+  static int hysteresis(int cur, int idx, double lat, double lon) {
+    if (cur != idx) {
+      bool keep = (cur < 0) || inRegion(cur, lat, lon, POINTPERFECT_HYSTERESIS_KM);
+      bool enter = (idx >= 0) && inRegion(idx, lat, lon, -POINTPERFECT_HYSTERESIS_KM);
+      if (keep && !enter) {
+        return cur;
+      }
+    }
+    return idx;
+  }
+
+  /** get a number from the store, must be called with the mutex taken
+   *  \param key  the parameter key    
+   *  \return     the value 
+   */
+  long getLong(KEY key) {
+    long num;
+    memcpy(&num, &store[offsets[key]], sizeof(num));
+    return num;
+  }
+
+  /** set a number in the store, must be called with the mutex taken
+   *  \param key  the parameter key    
+   *  \param num  the value 
+   */
+  void setLong(KEY key, long num) {
+    memcpy(&store[offsets[key]], &num, sizeof(num));
+  }
+
+  /** convert a value from the store to a string, a number 0 is converted to a empty string, 
+   *  must be called with the mutex taken
+   *  \param key  the parameter key    
+   *  \param buf  the buffer to store the value
+   *  \param len  the size of the buffer
+   *  \return     the length of the string, may be larger than len if truncated 
+   */
+  int toString(KEY key, char* buf, size_t len) {
+    if (TYPE_LONG == KEY_LUT[key].type) {
+      long num = getLong(key);
+      if (0 == num) {
+        *buf = '\0';
+        return 0;
+      }
+      return snprintf(buf, len, "%ld", num);
+    } 
+    return snprintf(buf, len, "%s", &store[offsets[key]]);
+  }
+
+  /** add all non empty keys, except blobs to a json document, must be called with the mutex taken
+   *  \param json  the json document to fill 
+   */
+  void exportJson(JsonDocument& json) {
+    for (int i = 0; i < KEY_NUM; i ++) {
+      const char* p = &store[offsets[i]];
+      if (TYPE_LONG == KEY_LUT[i].type) {
+        long num = getLong((KEY)i);
+        if (num) json[KEY_LUT[i].name] = num;
+      } else if ((TYPE_STRING == KEY_LUT[i].type) && *p) {
+        json[KEY_LUT[i].name] = p;
+      }
+    }
+  }
+  
+  /** take all known keys from a json document, must be called with the mutex taken
+   *  \param json  the json document to read
+   *  \return      true if the json document contained blobs that were moved to their own files
+   */
+  bool importJson(JsonDocument& json) {
+    bool migrated = false;
+    for (int i = 0; i < KEY_NUM; i ++) {
+      JsonVariantConst obj = json[KEY_LUT[i].name];
+      char* p = &store[offsets[i]];
+      if (TYPE_LONG == KEY_LUT[i].type) {
+        setLong((KEY)i, (!obj.isNull() && obj.is<long>()) ? obj.as<long>() : 0);
+      } else if (!obj.isNull() && obj.is<const char*>()) {
+        const char* value = obj.as<const char*>();
+        if (TYPE_BLOB == KEY_LUT[i].type) {
+          migrated = blobWrite((KEY)i, value) || migrated;
+        } else if (strlen(value) < KEY_LUT[i].size) {
+          strcpy(p, value);
+        } else {
+          log_w("key %s value too long, ignored", KEY_LUT[i].name);
+        }
+      }
+    }
+    return migrated;
+  }
+
+  /** assign a string or number value in the store, must be called with the mutex taken
+   *  \param key      the parameter key
+   *  \param value    the value to assign, converted for numbers
+   *  \param changed  optional, set to true if the value changed
+   *  \return         true if the value fits into the store
+   */
+  bool assign(KEY key, const char* value, bool* changed = NULL) {
+    bool diff = false;
+    if (TYPE_LONG == KEY_LUT[key].type) {
+      long num = atol(value);
+      diff = (getLong(key) != num);
+      setLong(key, num);
+    } else if ((TYPE_STRING != KEY_LUT[key].type) || (strlen(value) >= KEY_LUT[key].size)) {
+      return false;
+    } else {
+      char* p = &store[offsets[key]];
+      diff = (0 != strcmp(p, value));
+      strcpy(p, value);
+    }
+    if (changed) {
+      *changed = diff;
+    }
+    return true;
+  }
+
+  /** recover a blob whose write was interrupted, must be called with the mutex taken
+   *  \param key  the parameter key
+   */
+  void blobRecover(KEY key) {
+    char path[32];
+    char temp[32];
+    snprintf(path, sizeof(path), CONFIG_FFS_BLOB_FORMAT, KEY_LUT[key].name);
+    snprintf(temp, sizeof(temp), CONFIG_FFS_BLOB_TEMP, KEY_LUT[key].name);
+    if (SPIFFS.exists(temp)) {
+      if (SPIFFS.exists(path)) {
+        // the temporary file may be incomplete, the old blob is still valid
+        SPIFFS.remove(temp);
+      } else {
+        // the temporary file was complete, the rename did not happen
+        SPIFFS.rename(temp, path);
+        log_w("file \"FFS%s\" recovered", path);
+      }
+    }
+  }
+
+  /** read a blob from its file, must be called with the mutex taken
+   *  \param key  the parameter key
+   *  \param str  the string to read into
+   *  \return     true if the blob exists
+   */
+  bool blobRead(KEY key, String& str) {
+    if (dirty & (1UL << key)) {
+      // not yet written, an empty value is a pending delete
+      str = blobs[key];
+      return (0 < str.length());
+    }
+    char path[32];
+    snprintf(path, sizeof(path), CONFIG_FFS_BLOB_FORMAT, KEY_LUT[key].name);
+    bool ok = ffsOk && SPIFFS.exists(path);
+    if (ok) {
+      File file = SPIFFS.open(path, FILE_READ);
+      ok = file;
+      if (ok) {
+        str = file.readString();
+        file.close();
+      }
+    }
+    return ok;
+  }
+  
+  /** write a blob to its file, an empty value deletes the file, must be called with the mutex taken. 
+   *  The value is written to a temporary file first that replaces the blob, so that a reset never 
+   *  loses the old and the new value, an interrupted write is recovered by blobRecover(). 
+   *  \param key    the parameter key
+   *  \param value  the value to write
+   *  \return       true if the operation was sucessful
+   */
+  bool blobWrite(KEY key, const char* value) {
+    char path[32];
+    char temp[32];
+    snprintf(path, sizeof(path), CONFIG_FFS_BLOB_FORMAT, KEY_LUT[key].name);
+    snprintf(temp, sizeof(temp), CONFIG_FFS_BLOB_TEMP, KEY_LUT[key].name);
+    bool ok = ffsOk;
+    if (ok) {
+      size_t len = strlen(value);
+      if (0 < len) {
+        File file = SPIFFS.open(temp, FILE_WRITE);
+        ok = file && (len == file.write((const uint8_t*)value, len));
+        if (file) {
+          file.close();
+        }
+        if (ok) {
+          if (SPIFFS.exists(path)) {
+            SPIFFS.remove(path);
+          }
+          ok = SPIFFS.rename(temp, path);
+        } else if (SPIFFS.exists(temp)) {
+          SPIFFS.remove(temp);
+        }
+      } else if (SPIFFS.exists(path)) {
+        SPIFFS.remove(path);
+      }
+    }
+    if (!ok) {
+      log_e("file \"FFS%s\" write failed", path);
+    }
+    return ok;
+  }
+
+  /* FreeRTOS static task function, will just call the objects task function  
+   * \param pvParameters the Config object (this)
+   */
+  static void task(void * pvParameters) {
+    ((CONFIG*) pvParameters)->task();
+  }
+
+  /** This task persists the changes in the background, it waits until the changes are settled 
+   *  and compacts the journal once it gets too large.
+   */
+  void task(void) {
+    while (true) {
+      TickType_t wait = portMAX_DELAY;
+      bool doFlush = false;
+      if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+        if (savePending) {
+          int32_t left = ttagSave - millis();
+          doFlush = (0 >= left);
+          wait = doFlush ? 0 : pdMS_TO_TICKS(left);
+        } else if (compactPending) {
+          doFlush = true;
+        }
+        xSemaphoreGive(mutex);
+      }
+      if (doFlush) {
+        flush();
+      } else {
+        ulTaskNotifyTake(pdTRUE, wait);
+      }
+    }
+  }
+
+  /** write all changed keys to the journal and compact it if needed 
+   */
+  void flush(void) {
+    int32_t start = millis();
+    int records = 0;
+    int size = 0;
+    bool compacted = false;
+    if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+      savePending = false;
+      if (ffsOk) {
+        for (int i = 0; i < KEY_NUM; i ++) {
+          if ((dirty & (1UL << i)) && (TYPE_BLOB == KEY_LUT[i].type)) {
+            if (blobWrite((KEY)i, blobs[i].c_str())) {
+              dirty &= ~(1UL << i);
+              blobs[i] = String(); // release the memory, the file holds it now 
+            } else {
+              // retry later
+              savePending = true;
+              ttagSave = millis() + CONFIG_SAVE_DELAY;
+            }
+          }
+        }
+        uint32_t blobMask = 0;
+        for (int i = 0; i < KEY_NUM; i ++) {
+          if (TYPE_BLOB == KEY_LUT[i].type) {
+            blobMask |= 1UL << i;
+          }
+        }
+        if (dirty & ~blobMask) {
+          File file = SPIFFS.open(CONFIG_FFS_JOURNAL, FILE_APPEND);
+          if (file) {
+            for (int i = 0; i < KEY_NUM; i ++) {
+              if ((dirty & (1UL << i)) && (TYPE_BLOB != KEY_LUT[i].type)) {
+                if (journalWrite(file, (KEY)i)) {
+                  records ++;
+                } else {
+                  compactPending = true; // the journal is inconsistent now, fix it with a snapshot
+                }
+              }
+            }
+            size = file.size();
+            file.close();
+            dirty &= blobMask; // keep the blobs that failed
+          } else {
+            compactPending = true;
+          }
+        }
+        if (compactPending || (size > CONFIG_JOURNAL_MAX)) {
+          compacted = compact();
+          compactPending = !compacted;
+          if (!compacted) {
+            // retry later
+            savePending = true;
+            ttagSave = millis() + CONFIG_SAVE_DELAY;
+          }
+        }
+      }
+      xSemaphoreGive(mutex);
+    }
+    if (compacted) {
+      log_i("file \"FFS%s\" compacted in %d ms", CONFIG_FFS_FILE, millis() - start);
+    } else if (0 < records) {
+      log_d("file \"FFS%s\" %d records appended, size %d in %d ms", CONFIG_FFS_JOURNAL, records, size, millis() - start);
+    }
+  }
+
+  /** shutdown handler registered with the ESP-IDF, make sure pending changes are persisted before a software reset
+   */
+  static void onShutdown(void) {
+    if (Config.savePending) {
+      Config.flush();
+    }
+  }
+
+  /** append a record of a key to the journal, a record is the tag, name length, value length, name, 
+   *  value and a CRC32 over all previous bytes, must be called with the mutex taken
+   *  \param file  the journal file
+   *  \param key   the parameter key
+   *  \return      true if the record was written completely
+   */
+  bool journalWrite(File& file, KEY key) {
+    uint8_t record[3 + 32 + 256 + 4];
+    size_t nameLen = strlen(KEY_LUT[key].name);
+    if (nameLen > 32) {
+      return false;
+    }
+    char* value = (char*)&record[3 + nameLen];
+    int valueLen = toString(key, value, 256);
+    if (valueLen > 255) {
+      return false;
+    }
+    record[0] = CONFIG_JOURNAL_TAG;
+    record[1] = nameLen;
+    record[2] = valueLen;
+    memcpy(&record[3], KEY_LUT[key].name, nameLen);
+    size_t len = 3 + nameLen + valueLen;
+    uint32_t crc = crc32(record, len);
+    memcpy(&record[len], &crc, sizeof(crc));
+    len += sizeof(crc);
+    return len == file.write(record, len);
+  }
+
+  /** replay all records of the journal, must be called with the mutex taken
+   *  \return  the number of records replayed, or the negative number minus one if a corrupt record was found 
+   */
+  int journalReplay(void) {
+    int records = 0;
+    bool corrupt = false;
+    File file = SPIFFS.open(CONFIG_FFS_JOURNAL, FILE_READ);
+    if (file) {
+      uint8_t record[3 + 255 + 1 + 255 + 1];
+      while (!corrupt && (0 < file.available())) {
+        corrupt = (3 != file.read(record, 3)) || (CONFIG_JOURNAL_TAG != record[0]);
+        if (!corrupt) {
+          size_t len = 3 + record[1] + record[2];
+          uint32_t crc;
+          corrupt = (len - 3 != file.read(&record[3], len - 3)) || 
+                    (sizeof(crc) != file.read((uint8_t*)&crc, sizeof(crc))) || (crc != crc32(record, len));
+          if (!corrupt) {
+            // make name and value zero terminated strings
+            char* value = (char*)&record[3 + record[1] + 1];
+            memmove(value, &record[3 + record[1]], record[2]);
+            value[record[2]] = '\0';
+            record[3 + record[1]] = '\0';
+            KEY key = find((const char*)&record[3]);
+            if (KEY_NUM != key) {
+              assign(key, value);
+            }
+            records ++;
+          }
+        }
+      }
+      file.close();
+    }
+    return corrupt ? -records - 1 : records;
+  }
+
+  /** write a new snapshot and delete the journal, a interrupted compaction is recovered by read(), 
+   *  must be called with the mutex taken
+   *  \return  true if sucessful
+   */
+  bool compact(void) {
+    int len = 0;
+    File file = SPIFFS.open(CONFIG_FFS_TEMP, FILE_WRITE);
+    if (file) {
+      JsonDocument json;
+      exportJson(json);
+      len = serializeJson(json, file);
+      file.close();
+    }
+    bool ok = (0 < len);
+    if (ok) {
+      if (SPIFFS.exists(CONFIG_FFS_FILE)) {
+        SPIFFS.remove(CONFIG_FFS_FILE);
+      }
+      ok = SPIFFS.rename(CONFIG_FFS_TEMP, CONFIG_FFS_FILE);
+      if (ok && SPIFFS.exists(CONFIG_FFS_JOURNAL)) {
+        SPIFFS.remove(CONFIG_FFS_JOURNAL);
+      }
+    }
+    if (!ok) {
+      log_e("file \"FFS%s\" compaction failed", CONFIG_FFS_FILE);
+    }
+    return ok;
+  }
+
+  /** calculate a CRC32 (IEEE 802.3)  
+   *  \param ptr  the data
+   *  \param len  the size of the data
+   *  \return     the crc
+   */
+  static uint32_t crc32(const uint8_t* ptr, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (len--) {
+      crc ^= *ptr++;
+      for (int i = 0; i < 8; i ++) {
+        crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+      }
+    }
+    return ~crc;
+  }
+
+  /** increment the generation of the group of a key, must be called with the mutex taken
+   *  \param key  the parameter key
+   *  \return     the mask of the groups changed
+   */
+  uint32_t touch(KEY key) {
+    uint32_t group = KEY_LUT[key].group;
+    for (int i = 0; i < GROUP_NUM; i ++) {
+      if (group & (1 << i)) {
+        generation[i] ++;
+      }
+    }
+    return group;
+  }
+
+  /** wake all subscribers of the changed groups
+   *  \param groups  the mask of the changed groups
+   */
+  void notify(uint32_t groups) {
+    if (groups) {
+      for (int i = 0; i < CONFIG_MAX_SUBSCRIBERS; i ++) {
+        if ((NULL != subscribers[i].task) && (subscribers[i].groups & groups)) {
+          xTaskNotifyGive(subscribers[i].task);
+        }
+      }
+    }
+  }
   
   /** initialize the file system 
    *  \return  sucess of operation
@@ -582,11 +1418,55 @@ protected:
     return ffsOk;
   }    
 
-  JsonDocument json;   //!< a local copy of the json buffer
-  SemaphoreHandle_t mutex;    //!< protects json and FFS
+  char store[CONFIG_STORE_SIZE]; //!< the fixed-capacity storage of all keys except blobs 
+  uint16_t offsets[KEY_NUM];  //!< the offset of each key in store
+  SemaphoreHandle_t mutex;    //!< protects store and FFS
   bool ffsOk;                 //!< flag if the FFS is ok
   String title;               //!< the title of the device
   String name;                //!< the name of the device
+  volatile uint32_t generation[GROUP_NUM]; //!< generation counter for each key group
+  uint16_t grid[POINTPERFECT_GRID_ROWS * POINTPERFECT_GRID_COLS]; //!< regions overlapping each grid cell
+  int gridCell;               //!< the last cell if we can skip the lookup while we stay in it, -1 otherwise 
+  int regionIdx;              //!< the index of the current region, -1 for none, -2 for unknown
+  int freqIdx;                //!< the index of the entry providing the current frequency, -1 for none, -2 for unknown
+  long curFreq;               //!< the current frequency 
+  std::shared_ptr<const std::vector<String>> topicSet; //!< the current topic set shared by all clients
+  uint32_t topicSetGeneration; //!< the generation of topicSet
+  uint32_t dirty;             //!< mask of the keys changed since the last flush
+  String blobs[KEY_NUM];      //!< the changed blobs waiting to be written by the config task, empty for a delete
+  bool savePending;           //!< a save was requested and is waiting for CONFIG_SAVE_DELAY
+  bool compactPending;        //!< a new snapshot needs to be written 
+  int32_t ttagSave;           //!< time tag when the pending changes are written
+  TaskHandle_t saveTask;      //!< the task that persists the changes
+  struct { 
+    TaskHandle_t task;        //!< the task to notify
+    uint32_t groups;          //!< the groups the task is interested in
+  } subscribers[CONFIG_MAX_SUBSCRIBERS]; //!< the subscribers to changes 
+};
+   
+const CONFIG::KEYINFO CONFIG::KEY_LUT[CONFIG::KEY_NUM] = {
+  // name                         type                  group                   size
+  { CONFIG_VALUE_CLIENTID,        CONFIG::TYPE_STRING,  CONFIG::GROUP_MQTT,     40 },
+  { CONFIG_VALUE_ZTPTOKEN,        CONFIG::TYPE_STRING,  CONFIG::GROUP_MQTT,     40 },
+  { CONFIG_VALUE_STREAM,          CONFIG::TYPE_STRING,  CONFIG::GROUP_MQTT,      4 },
+  { CONFIG_VALUE_BROKERHOST,      CONFIG::TYPE_STRING,  CONFIG::GROUP_MQTT,     72 },
+  { CONFIG_VALUE_ROOTCA,          CONFIG::TYPE_BLOB,    CONFIG::GROUP_MQTT,      0 },
+  { CONFIG_VALUE_CLIENTCERT,      CONFIG::TYPE_BLOB,    CONFIG::GROUP_MQTT,      0 },
+  { CONFIG_VALUE_CLIENTKEY,       CONFIG::TYPE_BLOB,    CONFIG::GROUP_MQTT,      0 },
+  { CONFIG_VALUE_NTRIP_SERVER,    CONFIG::TYPE_STRING,  CONFIG::GROUP_NTRIP,    72 },
+  { CONFIG_VALUE_NTRIP_USERNAME,  CONFIG::TYPE_STRING,  CONFIG::GROUP_NTRIP,    72 },
+  { CONFIG_VALUE_NTRIP_PASSWORD,  CONFIG::TYPE_STRING,  CONFIG::GROUP_NTRIP,    72 },
+  { CONFIG_VALUE_NTRIP_VERSION,   CONFIG::TYPE_STRING,  CONFIG::GROUP_NTRIP,    16 },
+  { CONFIG_VALUE_NTRIP_GGA,       CONFIG::TYPE_STRING,  0,                      96 },
+  { CONFIG_VALUE_REGION,          CONFIG::TYPE_STRING,  CONFIG::GROUP_REGION,    4 },
+  { CONFIG_VALUE_FREQ,            CONFIG::TYPE_LONG,    CONFIG::GROUP_REGION,  sizeof(long) },
+  { CONFIG_VALUE_KEY,             CONFIG::TYPE_STRING,  0,                      92 },
+  { CONFIG_VALUE_USESOURCE,       CONFIG::TYPE_STRING,  CONFIG::GROUP_SOURCE,   40 },
+  { CONFIG_VALUE_LTEAPN,          CONFIG::TYPE_STRING,  0,                      72 },
+  { CONFIG_VALUE_SIMPIN,          CONFIG::TYPE_STRING,  0,                      12 },
+  { CONFIG_VALUE_MNOPROF,         CONFIG::TYPE_STRING,  0,                       8 },
+  { CONFIG_VALUE_LTECERTS,        CONFIG::TYPE_STRING,  0,                      33 },
+  { CONFIG_VALUE_LTEBAUD,         CONFIG::TYPE_STRING,  0,                      24 }
 };
    
 CONFIG Config; //!< The global CONFIG object
@@ -19,6 +19,8 @@
 
 #include <SparkFun_u-blox_GNSS_Arduino_Library.h>
 
+#include "TIMELINE.h"
+
 /** Configure the dynamic model of the receiver
  *  possible choice is between AUTOMOTIVE, SCOOTER, MOWER, PORTABLE (=no DR), UNKNOWN (= no change)
  */
@@ -39,6 +41,11 @@ const int32_t GNSS_ODO_FACTOR = (uint32_t)( 0.53 /* wheel circumference m */
 const int GNSS_DETECT_RETRY       =        1000;  //!< Try to detect the received with this intervall
 const int GNSS_CORRECTION_TIMEOUT =       12000;  //!< If the current correction source has not received data for this period we will switch to the next source that receives data. 
 const int GNSS_I2C_ADR            =        0x42;  //!< ZED-F9x I2C address
+const int GNSS_SOS_TIMEOUT        =        2000;  //!< Wait this long for the UBX-UPD-SOS backup acknowledge 
+const int GNSS_SHUTDOWN_TIMEOUT   =        3000;  //!< The shutdown handler waits this long for the poll task to complete the backup
+const uint32_t GNSS_SOS_STOPPED   =  0x53544F50;  //!< Magic value ("STOP") kept over a software reset to signal that the GNSS was stopped
+const int GNSS_CHUNK_SIZE         =         512;  //!< Size of the pool chunks used to queue data to the receiver
+const int GNSS_CHUNK_NUM          =          24;  //!< Number of pool chunks, a 9kB MGA message needs 18 of them
 
 // helper macro for source handling (selection in the receiver)
 #define GNSS_SPARTAN_USESOURCE(source)      ((source == LBAND) ?  1      : 0)           //!< convert from internal source to USE_SOUCRE value
@@ -51,6 +58,8 @@ const int GNSS_I2C_ADR            =        0x42;  //!< ZED-F9x I2C address
 #define GNSS_CHECK_EVAL(txt)      if (!_ok) log_e(txt ", sequence failed at step %d", _step) //!< final verdict and log_e report
             
 extern class GNSS Gnss; //!< Forward declaration of class
+
+RTC_NOINIT_ATTR uint32_t gnssSosStopped; //!< survives a software reset, set to GNSS_SOS_STOPPED after a backup stopped the GNSS
     
 /** This class encapsulates all GNSS functions. 
 */
@@ -62,12 +71,26 @@ public:
    */
   GNSS(void) {
     queue = xQueueCreate( 10, sizeof( MSG ) );
+    chunkMutex = xSemaphoreCreateMutex();
+    chunkFreeList = NULL;
+    for (int i = 0; i < GNSS_CHUNK_NUM; i ++) {
+      chunkPool[i].next = chunkFreeList;
+      chunkFreeList = &chunkPool[i];
+    }
     online = false;
     ttagNextTry = millis();
     curSource = NONE;
     for (int i = 0; i < SOURCE::NUM; i ++) {
       ttagSource[i] = ttagNextTry;
     }
+    ttagDetect = ttagNextTry;
+    fixLogged = false;
+    tmPending = false;
+    sosRestore = SOS_UNKNOWN;
+    sosRequest = false;
+    sosDone = xSemaphoreCreateBinary();
+    pollTask = NULL;
+    esp_register_shutdown_handler(onShutdown);
   }
 
   /** get, decode and dump the version
@@ -101,21 +124,25 @@ public:
    */
   bool detect(void) {
     //rx.enableDebugging();
-    rx.setOutputPort(Websocket);    // forward all messages
+    rx.setOutputPort(Websocket.gnssPort);    // forward all messages
 #ifdef __BLUETOOTH_H__
     rx.setNMEAOutputPort(Bluetooth); // forward NMEA messages
 #endif
     bool ok = rx.begin(UbxWire, GNSS_I2C_ADR); //Connect to the Ublox module using Wire port
     if (ok) {
       log_i("receiver detected");
+      ttagDetect = millis();
+      fixLogged = false;
 
       String fwver = version("GNSS", &rx);
+      sosCheck();
       if ((fwver.substring(4).toDouble() <= 1.30) && !fwver.substring(4).equals("1.30")) { 
         // ZED-F9R/P old release firmware, no Spartan 2.0 support
         log_e("firmware \"%s\" is old, please update firmware to release \"HPS 1.30\"", fwver.c_str());
       } 
       GNSS_CHECK_INIT;
       GNSS_CHECK(1) = rx.setAutoPVTcallbackPtr(onPVT);
+      GNSS_CHECK(15) = rx.setAutoHPPOSLLHcallbackPtr(onHPPOSLLH); // high precision part of the monitor telemetry
 //#define GNNS_BASE
 #ifdef GNNS_BASE
       GNSS_CHECK(11) = rx.setAutoNAVSVINcallbackPtr(onUBXNAVSVIN);
@@ -163,8 +190,9 @@ public:
       GNSS_CHECK_EVAL("configuration");
       if (ok) {
         log_i("configuration complete, receiver online");
+        Timeline.mark(TIMELINE::GNSS);
         uint8_t key[64];
-        int keySize = Config.getValue(CONFIG_VALUE_KEY, key, sizeof(key));
+        int keySize = Config.getValue(CONFIG::KEY_PPKEY, key, sizeof(key));
         if (keySize > 0) {
           log_i("inject saved keys");
           inject(key, keySize, KEYS);
@@ -176,12 +204,60 @@ public:
 
   typedef enum                          {  WLAN = 0, LTE,   LBAND,   KEYS,   WEBSOCKET,   BLUETOOTH,   NONE, NUM } SOURCE; //!< source enum for MSG 
   const char* SOURCE_LUT[SOURCE::NUM] = { "WLAN",   "LTE", "LBAND", "KEYS", "WEBSOCKET", "BLUETOOTH", "-"        };  //!< source to text conversion
+  typedef struct CHUNK { 
+    struct CHUNK* next;             //!< next chunk in the chain 
+    size_t size;                    //!< bytes used in data
+    uint8_t data[GNSS_CHUNK_SIZE];  //!< the data
+  } CHUNK;                          //!< fixed size pool chunk, chained to hold a message 
   typedef struct { 
-    SOURCE source;      //!< source of data 
-    uint8_t* data;      //!< data buffer, allocated by calling task and released  by consumers  
-    size_t size;        //!< data size
-  } MSG;                //!< queue element
-  xQueueHandle queue;   //!< queue to hold the different data to be sent to the receiver
+    SOURCE source;          //!< source of data 
+    uint8_t* data = NULL;   //!< data buffer, allocated by calling task and released  by consumers  
+    CHUNK* chunks = NULL;   //!< alternatively to data the message is held in a chain of pool chunks
+    size_t size;            //!< data size
+  } MSG;                    //!< queue element
+  xQueueHandle queue;       //!< queue to hold the different data to be sent to the receiver
+
+  /** allocate a chunk from the pool, this never allocates heap memory 
+   *  \return  the chunk or NULL if the pool is exhausted
+   */
+  CHUNK* chunkAlloc(void) {
+    CHUNK* chunk = NULL;
+    if (pdTRUE == xSemaphoreTake(chunkMutex, portMAX_DELAY)) {
+      chunk = chunkFreeList;
+      if (NULL != chunk) {
+        chunkFreeList = chunk->next;
+        chunk->next = NULL;
+        chunk->size = 0;
+      }
+      xSemaphoreGive(chunkMutex);
+    }
+    return chunk;
+  }
+
+  /** return a chain of chunks to the pool 
+   *  \param chunk  the first chunk of the chain, can be NULL
+   */
+  void chunkFree(CHUNK* chunk) {
+    if ((NULL != chunk) && (pdTRUE == xSemaphoreTake(chunkMutex, portMAX_DELAY))) {
+      while (NULL != chunk) {
+        CHUNK* next = chunk->next;
+        chunk->next = chunkFreeList;
+        chunkFreeList = chunk;
+        chunk = next;
+      }
+      xSemaphoreGive(chunkMutex);
+    }
+  }
+
+  /** free the data of a message, regardless if held in a buffer or chunks 
+   *  \param msg  the message
+   */
+  void msgFree(MSG& msg) {
+    delete [] msg.data;
+    msg.data = NULL;
+    chunkFree(msg.chunks);
+    msg.chunks = NULL;
+  }
 
   /** inject a message into the queue to be sent to the receiver, 
    *  \param msg  message to be added, this msg.data is freed by  
@@ -191,8 +267,7 @@ public:
     if (xQueueSendToBack(queue, &msg, 0/*portMAX_DELAY*/) == pdPASS) {
       return msg.size;
     }
-    delete [] msg.data;
-    msg.data = NULL;
+    msgFree(msg);
     log_e("%d bytes from %s source failed, queue full", msg.size, SOURCE_LUT[msg.source]);
     return 0;
   }
@@ -205,11 +280,30 @@ public:
    */
   size_t inject(const uint8_t* ptr, size_t len, SOURCE src) {
     MSG msg;
+    msg.size = len;
+    msg.source = src;
+    // copy into a chain of pool chunks, this avoids large allocations from the heap
+    CHUNK** tail = &msg.chunks;
+    size_t pos = 0;
+    while (pos < len) {
+      CHUNK* chunk = chunkAlloc();
+      if (NULL == chunk) {
+        break;
+      }
+      chunk->size = ((len - pos) < GNSS_CHUNK_SIZE) ? (len - pos) : GNSS_CHUNK_SIZE;
+      memcpy(chunk->data, &ptr[pos], chunk->size);
+      pos += chunk->size;
+      *tail = chunk;
+      tail = &chunk->next;
+    }
+    if (pos == len) {
+      return inject(msg);
+    }
+    // the pool is exhausted, fall back to the heap 
+    msgFree(msg);
     msg.data = new uint8_t[len];
     if (NULL != msg.data) {
       memcpy(msg.data, ptr, len);
-      msg.size = len;
-      msg.source = src;
       return inject(msg);
     }
     log_e("%d bytes from %s source failed, no memory", msg.size, SOURCE_LUT[msg.source]);
@@ -220,6 +314,15 @@ public:
    *  callbacks are processed and the queue is processed and its data is sent to the reciever.  
    */
   void poll(void) {
+    pollTask = xTaskGetCurrentTaskHandle();
+    if (sosRequest) {
+      // a backup was requested by the shutdown handler running in a different task
+      sosRequest = false;
+      if (online) {
+        sosBackup();
+      }
+      xSemaphoreGive(sosDone);
+    }
     int32_t now = millis();
     if (0 >= (ttagNextTry - now)) {
       ttagNextTry = now + GNSS_DETECT_RETRY;
@@ -236,10 +339,20 @@ public:
       while (xQueueReceive(queue, &msg, 0/*portMAX_DELAY*/) == pdPASS) {
         if (online) {
           checkSpartanUseSourceCfg(msg.source);
-          online = rx.pushRawData(msg.data, msg.size);
+          if (NULL != msg.chunks) {
+            // push the chain chunk by chunk 
+            for (CHUNK* chunk = msg.chunks; online && (NULL != chunk); chunk = chunk->next) {
+              online = rx.pushRawData(chunk->data, chunk->size);
+            }
+          } else {
+            online = rx.pushRawData(msg.data, msg.size);
+          }
           if (online) {
             len += msg.size;
             log_d("%d bytes from %s source", msg.size, SOURCE_LUT[msg.source]);
+            if (msg.source != KEYS) {
+              Timeline.mark(TIMELINE::CORRECTION);
+            }
           } else {
             log_e("%d bytes from %s source failed", msg.size, SOURCE_LUT[msg.source]);
           }
@@ -247,16 +360,103 @@ public:
         // Forward also messages from the IP services (LTE and WIFI) to the GUI though the WEBSOCKET
         // LBAND and GNSS are already sent directly, and we dont want KEYS and WEBSOCKET injections to loop back to the GUI
         if ((msg.source == WLAN) || (msg.source == LTE)) {
-          Websocket.write(msg.data, msg.size, (msg.source == LTE)  ? WEBSOCKET::SOURCE::LTE : WEBSOCKET::SOURCE::WLAN);
+          WEBSOCKET::SOURCE source = (msg.source == LTE)  ? WEBSOCKET::SOURCE::LTE : WEBSOCKET::SOURCE::WLAN;
+          if (NULL != msg.chunks) {
+            for (CHUNK* chunk = msg.chunks; NULL != chunk; chunk = chunk->next) {
+              Websocket.write(chunk->data, chunk->size, source);
+            }
+          } else {
+            Websocket.write(msg.data, msg.size, source);
+          }
         }
-        delete [] msg.data;
-        msg.data = NULL;
+        msgFree(msg);
       }
     }
   }
 
+  /** Stop the receiver in a controlled way and create a backup of the navigation state in its flash 
+   *  using UBX-UPD-SOS. On the next power up the receiver restores it and can do a hot start. 
+   *  The receiver remains stopped until it is power cycled or restarted by detect(). 
+   *  \return  true if the backup was acknowledged by the receiver
+   */
+  bool sosBackup(void) {
+    int32_t start = millis();
+    // controlled GNSS stop (resetMode 0x08) with navBbrMask 0x0000, this command is not acknowledged
+    uint8_t rst[4] = { 0x00, 0x00, 0x08, 0x00 };
+    ubxPacket cfgRst = { UBX_CLASS_CFG, UBX_CFG_RST, sizeof(rst), 0, 0, rst, 0, 0, SFE_UBLOX_PACKET_VALIDITY_NOT_DEFINED, SFE_UBLOX_PACKET_VALIDITY_NOT_DEFINED};
+    rx.sendCommand(&cfgRst, 0);
+    gnssSosStopped = GNSS_SOS_STOPPED;
+    // create backup (cmd 0), the receiver responds with UBX-UPD-SOS cmd 2, response 1 = acknowledged 
+    struct { uint8_t cmd; uint8_t reserved0[3]; uint8_t response; uint8_t reserved1[3]; } sos = { 0 };
+    ubxPacket cfgSos = { UBX_CLASS_UPD, UBX_UPD_SOS, 4, 0, 0, (uint8_t*)&sos, 0, 0, SFE_UBLOX_PACKET_VALIDITY_NOT_DEFINED, SFE_UBLOX_PACKET_VALIDITY_NOT_DEFINED};
+    bool ok = (rx.sendCommand(&cfgSos, GNSS_SOS_TIMEOUT) == SFE_UBLOX_STATUS_DATA_RECEIVED) && (sos.cmd == 2) && (sos.response == 1);
+    if (ok) {
+      log_i("backup created in %d ms", millis() - start);
+    } else {
+      log_e("backup failed, cmd %d response %d", sos.cmd, sos.response);
+    }
+    return ok;
+  }
+
 protected:
 
+  typedef enum                                  { SOS_UNKNOWN = 0, SOS_FAILED, SOS_RESTORED, SOS_NOBACKUP, SOS_NUM } SOS_RESTORE; //!< UBX-UPD-SOS restore response
+  const char* SOS_RESTORE_LUT[SOS_RESTORE::SOS_NUM] = { "unknown", "failed", "restored", "no backup" };                        //!< restore response to text conversion
+
+  /** Check the UBX-UPD-SOS restore status reported by the receiver after startup and restart 
+   *  the receiver if it was stopped by a backup before a software reset of the ESP32.
+   */
+  void sosCheck(void) {
+    // poll the restore status, the response has cmd 3, payload fits into the default packetCfg size 
+    struct { uint8_t cmd; uint8_t reserved0[3]; uint8_t response; uint8_t reserved1[3]; } sos = { 0 };
+    ubxPacket cfg = { UBX_CLASS_UPD, UBX_UPD_SOS, 0, 0, 0, (uint8_t*)&sos, 0, 0, SFE_UBLOX_PACKET_VALIDITY_NOT_DEFINED, SFE_UBLOX_PACKET_VALIDITY_NOT_DEFINED};
+    sosRestore = SOS_UNKNOWN;
+    if ((rx.sendCommand(&cfg, 300) == SFE_UBLOX_STATUS_DATA_RECEIVED) && (sos.cmd == 3) && (sos.response < SOS_NUM)) {
+      sosRestore = (SOS_RESTORE)sos.response;
+    }
+    if (gnssSosStopped == GNSS_SOS_STOPPED) {
+      // the receiver was not power cycled, it still holds the navigation state, just start it again (resetMode 0x09)
+      uint8_t rst[4] = { 0x00, 0x00, 0x09, 0x00 };
+      ubxPacket cfgRst = { UBX_CLASS_CFG, UBX_CFG_RST, sizeof(rst), 0, 0, rst, 0, 0, SFE_UBLOX_PACKET_VALIDITY_NOT_DEFINED, SFE_UBLOX_PACKET_VALIDITY_NOT_DEFINED};
+      rx.sendCommand(&cfgRst, 0);
+      sosRestore = SOS_RESTORED;
+      log_i("restore skipped, receiver was stopped and is restarted, hot start");
+    } else {
+      log_i("restore %s, %s", SOS_RESTORE_LUT[sosRestore], (sosRestore == SOS_RESTORED) ? "hot start" : "no hot start");
+    }
+    gnssSosStopped = 0;
+  }
+  
+  /** Shutdown handler registered with the ESP-IDF, called before a software reset, 
+   *  the backup is done by the task that polls the receiver to avoid concurrent access.
+   */
+  static void onShutdown(void) {
+    if (Gnss.online) {
+      if (Gnss.pollTask == xTaskGetCurrentTaskHandle()) {
+        Gnss.sosBackup();
+      } else if (Gnss.pollTask != NULL) {
+        xSemaphoreTake(Gnss.sosDone, 0); // drain a late response of an earlier request that timed out
+        Gnss.sosRequest = true;
+        if (pdTRUE != xSemaphoreTake(Gnss.sosDone, pdMS_TO_TICKS(GNSS_SHUTDOWN_TIMEOUT))) {
+          Gnss.sosRequest = false;
+          log_e("backup timeout");
+        }
+      }
+    }
+  }
+
+  SOS_RESTORE sosRestore;             //!< the restore status reported by the receiver during the last detect
+  volatile bool sosRequest;           //!< the shutdown handler requests a backup from the poll task
+  SemaphoreHandle_t sosDone;          //!< signaled by the poll task once the requested backup completed
+  TaskHandle_t pollTask;              //!< the task that calls poll and owns the receiver
+  int32_t ttagDetect;                 //!< time (millis()) when the receiver was detected
+  bool fixLogged;                     //!< flag that indicates that the time to first 3D fix was reported
+  CHUNK chunkPool[GNSS_CHUNK_NUM];    //!< the pool chunks used for queuing data to the receiver
+  CHUNK* chunkFreeList;               //!< list of the free chunks in the pool
+  SemaphoreHandle_t chunkMutex;       //!< protects the chunk free list
+  WEBSOCKET::TELEMETRY tm;            //!< the monitor telemetry of the last UBX-NAV-PVT, waiting for the UBX-NAV-HPPOSLLH of the same epoch
+  bool tmPending;                     //!< tm was not yet sent
+  
   SOURCE curSource;                   //!< current source in use of correction data
   uint32_t ttagSource[SOURCE::NUM];   //!< the time (millis()) of last correction data reception for each source
   
@@ -304,27 +504,92 @@ protected:
             fLat, fLon, 1e-3 * ubxDataStruct->hMSL, fixType, fixLut[fixType & 7], carrSoln, carrLut[carrSoln & 3], 
             1e-3*ubxDataStruct->hAcc, Gnss.SOURCE_LUT[Gnss.curSource]);
             
+      // report time to first 3D fix so that the gain of a hot start can be measured 
+      if (!Gnss.fixLogged && ((3 == fixType) || (4 == fixType)) && (ubxDataStruct->flags.bits.gnssFixOK)) {
+        Gnss.fixLogged = true;
+        int32_t now = millis();
+        log_i("first 3D fix after %d ms since boot, %d ms since detect, restore %s", 
+              now, now - Gnss.ttagDetect, Gnss.SOS_RESTORE_LUT[Gnss.sosRestore]);
+      }
+      // record the first RTK solutions in the boot timeline
+      if (carrSoln >= 1) {
+        Timeline.mark(TIMELINE::FLOAT);
+        if (carrSoln >= 2) {
+          Timeline.mark(TIMELINE::FIX);
+        }
+      }
       // update the pointperfect topic and lband frequency depending on region we are in
       if ((fixType != 0) && (ubxDataStruct->flags.bits.gnssFixOK)) {
         Config.updateLocation(fLat, fLon);
       }
       // forward a message to the websocket for the simple built in monitor
+#ifdef WEBSOCKET_TELEMETRY_TEXT
       char string[128];
       snprintf(string, sizeof(string), "%02d:%02d:%02d %s %s %s %.3f %.7f %.7f %.3f\r\n",
             ubxDataStruct->hour, ubxDataStruct->min,ubxDataStruct->sec, Gnss.SOURCE_LUT[Gnss.curSource], 
             fixLut[fixType & 7], carrLut[carrSoln & 3], 1e-3*ubxDataStruct->hAcc, fLat, fLon, 1e-3 * ubxDataStruct->hMSL);
       Websocket.write(string, WEBSOCKET::SOURCE::GNSS);
+#else
+      // UBX-NAV-HPPOSLLH of the same epoch is processed after this callback, if the last one did not show up send it without 
+      if (Gnss.tmPending) {
+        Websocket.write(&Gnss.tm, sizeof(Gnss.tm), WEBSOCKET::SOURCE::GNSS);
+      }
+      WEBSOCKET::TELEMETRY& tm = Gnss.tm;
+      memcpy(tm.magic, WEBSOCKET_TELEMETRY_MAGIC, sizeof(tm.magic));
+      tm.version  = WEBSOCKET_TELEMETRY_VERSION;
+      tm.source   = Gnss.curSource;
+      tm.fixType  = fixType;
+      tm.carrSoln = carrSoln;
+      tm.flags    = (ubxDataStruct->flags.bits.gnssFixOK ? WEBSOCKET::TELEMETRY_FIXOK : 0) | 
+                    (ubxDataStruct->flags.bits.diffSoln  ? WEBSOCKET::TELEMETRY_DIFF  : 0);
+      tm.numSV    = ubxDataStruct->numSV;
+      tm.corrAge  = ubxDataStruct->flags3.bits.lastCorrectionAge;
+      tm.year     = ubxDataStruct->year;
+      tm.month    = ubxDataStruct->month;
+      tm.day      = ubxDataStruct->day;
+      tm.hour     = ubxDataStruct->hour;
+      tm.min      = ubxDataStruct->min;
+      tm.sec      = ubxDataStruct->sec;
+      tm.iTOW     = ubxDataStruct->iTOW;
+      tm.lat      = ubxDataStruct->lat;
+      tm.lon      = ubxDataStruct->lon;
+      tm.height   = ubxDataStruct->height;
+      tm.hMSL     = ubxDataStruct->hMSL;
+      tm.hAcc     = ubxDataStruct->hAcc;
+      tm.vAcc     = ubxDataStruct->vAcc;
+      tm.latHp = tm.lonHp = tm.heightHp = tm.hMSLHp = 0;
+      Gnss.tmPending = true; // sent by onHPPOSLLH
+#endif
       // keep a GGA sentence for the NTRIP client
       saveGGA(ubxDataStruct);
     }
   }
 
+  /** add the high precision part of the UBX-NAV-HPPOSLLH message to the monitor telemetry of the 
+   *  same epoch and send it 
+   *  \param ubxDataStruct  the UBX-NAV-HPPOSLLH payload
+   */
+  static void onHPPOSLLH(UBX_NAV_HPPOSLLH_data_t *ubxDataStruct) {
+    if (ubxDataStruct && Gnss.tmPending && (Gnss.tm.iTOW == ubxDataStruct->iTOW)) {
+      WEBSOCKET::TELEMETRY& tm = Gnss.tm;
+      if (!(ubxDataStruct->flags & 1/*invalidLlh*/)) {
+        tm.flags   |= WEBSOCKET::TELEMETRY_HP;
+        tm.latHp    = ubxDataStruct->latHp;
+        tm.lonHp    = ubxDataStruct->lonHp;
+        tm.heightHp = ubxDataStruct->heightHp;
+        tm.hMSLHp   = ubxDataStruct->hMSLHp;
+      }
+      Websocket.write(&tm, sizeof(tm), WEBSOCKET::SOURCE::GNSS);
+      Gnss.tmPending = false;
+    }
+  }
+
 #ifdef GNSS_BASE
   static void onUBXNAVSVIN(UBX_NAV_SVIN_data_t *ubxDataStruct) {
     Gnss._onUBXNAVSVIN(ubxDataStruct);
   }
   void _onUBXNAVSVIN(UBX_NAV_SVIN_data_t *ubxDataStruct) {
-    bool enabled = Config.getValue(CONFIG_VALUE_NTRIP_SERVER).length() > 0;
+    bool enabled = Config.getValue(CONFIG::KEY_NTRIP_SERVER).length() > 0;
     static int valid = -1;
     if (!ubxDataStruct->active && enabled) {
       GNSS_CHECK_INIT;
@@ -389,7 +654,7 @@ protected:
         crc ^= string[i];
       }
       len += sprintf(&string[len], "*%02X", crc);
-      Config.setValue(CONFIG_VALUE_NTRIP_GGA, string);
+      Config.setValue(CONFIG::KEY_NTRIP_GGA, string);
     }
   } 
   
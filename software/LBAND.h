@@ -40,6 +40,8 @@ public:
     qzss = false;
     curFreq = 0;
     curPower = false;
+    configGeneration = 0;
+    configRetry = false;
     ttagNextTry = millis();
   }
 
@@ -48,19 +50,22 @@ public:
    */
   bool detect(void) {
     //rx.enableDebugging()
-    rx.setOutputPort(Websocket); // forward all messages
+    rx.setOutputPort(Websocket.lbandPort); // forward all messages
     bool ok = rx.begin(UbxWire, LBAND_I2C_ADR);
     if (ok) {
       log_i("receiver detected");
       String fwver = GNSS::version("LBAND", &rx);
       qzss = fwver.startsWith("QZS");
-      String useSrc = Config.getValue(CONFIG_VALUE_USESOURCE);
-      bool useLband = (-1 != useSrc.indexOf("LBAND"));
+      configGeneration = Config.getGeneration(CONFIG::GROUP_SOURCE | CONFIG::GROUP_REGION);
+      configRetry = false;
+      char useSrc[40];
+      Config.getValue(CONFIG::KEY_USESOURCE, useSrc, sizeof(useSrc));
+      bool useLband = (NULL != strstr(useSrc, "LBAND"));
       GNSS_CHECK_INIT;
       GNSS_CHECK(1) = rx.setVal32(UBLOX_CFG_UART2_BAUDRATE,         38400, VAL_LAYER_RAM);
       if (qzss) { // NEO-D9C
         curFreq = 0;
-        curPower = useLband && Config.getValue(CONFIG_VALUE_REGION).equals("jp");
+        curPower = useLband && Config.equals(CONFIG::KEY_REGION, "jp");
         rx.setRXMQZSSL6messageCallbackPtr(onRXMQZSSL6);
         // prepare the UART 2
         GNSS_CHECK(2) = rx.setVal(UBLOX_CFG_MSGOUT_UBX_RXM_QZSSL6_UART2,  1, VAL_LAYER_RAM);
@@ -84,6 +89,7 @@ public:
       online = ok = GNSS_CHECK_OK;
       GNSS_CHECK_EVAL("configuration");
       if (ok) {
+        Timeline.mark(TIMELINE::LBAND);
         rx.softwareEnableGNSS(curPower);
         if (qzss) {
           log_i("configuration complete, receiver online, %s", curPower ? "started" : "stopped");
@@ -95,8 +101,8 @@ public:
     return ok;
   }
 
-  /** This needs to be called from a task periodically, it makes sure the receiver is detected 
-   *  and callbacks are processed. 
+  /** This needs to be called from a task periodically, it makes sure the receiver is detected, 
+   *  configuration changes are applied and callbacks are processed. 
    */
   void poll(void) {
     int32_t now = millis();
@@ -104,11 +110,17 @@ public:
       ttagNextTry = now + GNSS_DETECT_RETRY;
       if (!online) {
         detect();
-      } else {
-        config();
+      } else if (configRetry) {
+        configRetry = !config();
       }
     }
     if (online) {
+      // only re-read the configuration if the source or region changed
+      uint32_t generation = Config.getGeneration(CONFIG::GROUP_SOURCE | CONFIG::GROUP_REGION);
+      if (configGeneration != generation) {
+        configGeneration = generation;
+        configRetry = !config();
+      }
       rx.checkUblox(); 
       rx.checkCallbacks();
     }
@@ -166,14 +178,16 @@ protected:
 
   /** Make sure that the receiver has the right frequency configured, this depends on the region/location and 
    *  switch power off if the region does not support the signal or have a LBAND frequency to recive
+   *  \return  true if the configuration was applied, false if it needs to be retried later
    */
-  void config(void) {
-    // do update the ferquency from time to time
-    String useSrc = Config.getValue(CONFIG_VALUE_USESOURCE);
-    bool useLband = (-1 != useSrc.indexOf("LBAND"));
+  bool config(void) {
+    bool ok = true;
+    char useSrc[40];
+    Config.getValue(CONFIG::KEY_USESOURCE, useSrc, sizeof(useSrc));
+    bool useLband = (NULL != strstr(useSrc, "LBAND"));
     bool newPower;
     if (qzss) {
-      newPower = useLband && Config.getValue(CONFIG_VALUE_REGION).equals("jp");
+      newPower = useLband && Config.equals(CONFIG::KEY_REGION, "jp");
     } else {
       int newFreq = Config.getFreq();
       newPower = useLband && (0 < newFreq);
@@ -191,6 +205,7 @@ protected:
         } else {
           log_w("config freq %d, failed, retry later", newFreq);
           newPower = curPower; // don't change the power in that case
+          ok = false;
         }
       }
     }
@@ -199,6 +214,7 @@ protected:
       curPower = newPower;
       log_i("%s", newPower ? "started" : "stopped");
     }
+    return ok;
   }
   
   bool online;            //!< flag that indicates if the receiver is connected
@@ -207,6 +223,8 @@ protected:
   uint32_t curFreq;       //!< the current configured frequency
   bool curPower;          //!< the current power mode
   bool qzss;              //!<true if the receiver is a NEO-D9C 
+  uint32_t configGeneration; //!< the generation of the configuration last applied
+  bool configRetry;       //!< the last configuration failed and needs to be retried 
 };
 
 LBAND LBand; //!< The global GNSS peripherial object
@@ -19,8 +19,10 @@
 
 #include <base64.h>
 #include <SparkFun_u-blox_SARA-R5_Arduino_Library.h>
+#include <MD5Builder.h>
 
 #include "HW.h"
+#include "TIMELINE.h"
 #include "CONFIG.h"
 #include "GNSS.h"
 #include "UBXFILE.h"
@@ -28,10 +30,22 @@
 const int LTE_1S_RETRY            =        1000;  //!< standard 1s retry
 const int LTE_DETECT_RETRY        =        5000;  //!< delay between detect attempts
 const int LTE_CHECKSIM_RETRY      =       60000;  //!< delay between SIM Card check attempts, SIM detection may be disables and you need to restart
-const int LTE_ACTIVATION_RETRY    =       10000;  //!< delay between activation attempts
 const int LTE_PROVISION_RETRY     =       60000;  //!< delay between provisioning attempts, provisioning may consume data
-const int LTE_CONNECT_RETRY       =       10000;  //!< delay between server connection attempts to correction severs 
+const int LTE_BACKOFF_MIN         =        1000;  //!< first delay between activation or connection attempts, it is doubled after each failed attempt
+const int LTE_BACKOFF_MAX         =       60000;  //!< the delay between activation or connection attempts is limited to this
+const int LTE_ACTIVATE_RETRY      =       10000;  //!< minimal delay between activation attempts, a new attempt would tear down the pending activation
+const int LTE_LOGIN_TIMEOUT       =       10000;  //!< wait this long for the MQTT login URC before trying again
+const int LTE_ATTACH_CHECK        =           2;  //!< after this many failed connection attempts check that registration and PDP context are still up
 const int LTE_MQTTCMD_DELAY       =         100;  //!< the client is not happy if multiple commands are sent too fast
+const int LTE_NTRIP_READ_SIZE     =        1024;  //!< size of the reusable buffer used when draining the NTRIP socket
+const int LTE_NTRIP_DRAIN_TIMEOUT =        2000;  //!< the +UUSORD URC delivers the NTRIP data, if it was quiet for this time the socket is drained manually
+const bool LTE_NTRIP_DIRECTLINK   =       false;  //!< stream the NTRIP socket in direct link mode (AT+USODL), no AT commands are possible while streaming
+const int LTE_DIRECTLINK_TRIGGER  =          50;  //!< in direct link mode data written to the UART is sent to the socket after this idle time (GGA)
+const int LTE_DIRECTLINK_GUARD    =        1200;  //!< the guard time before and after the "+++" escape sequence, the modem requires at least 1s
+const int LTE_DIRECTLINK_TIMEOUT  =       10000;  //!< leave the direct link mode if no data was received for this time
+const int LTE_SECMNG_TIMEOUT      =        5000;  //!< timeout for querying the MD5 of the credentials stored in the modem
+const int LTE_MQTTCMD_TIMEOUT     =        5000;  //!< give up waiting for a subscribe / unsubscribe URC after this time and retry
+const bool LTE_MQTT_WILDCARD      =        true;  //!< combine the correction topics of a region into a single wildcard subscription (not on LENA-R8)
 
 const int LTE_POWER_ON_PULSE        =      2000;  //!< Power on pulse width (2s works for for SARA, LARA and LENA)
 const int LTE_POWER_ON_WAITTIME     =      4000;  //!< Dont't do anything duing this time after the power on pulse
@@ -48,10 +62,13 @@ const char* FILE_RESP             = "resp.json";  //!< Temporarly file name used
 const char* SEC_ROOT_CA           ="aws-rootCA";  //!< Temporarly file name used when injecting the ROOT CA
 const char* SEC_CLIENT_CERT       =   "pp-cert";  //!< Temporarly file name used when injecting the client certificate
 const char* SEC_CLIENT_KEY        =    "pp-key";  //!< Temporarly file name used when injecting the client keys
+const char* FILE_BAUDTEST         =  "baud.txt";  //!< Temporarly file name used for the loopback burst verifying a baudrate
 
 const uint16_t HTTPS_PORT         =         443;  //!< The HTTPS default port
 
-const int LTE_BAUDRATE            =      115200;  //!< baudrates 230400, 460800 or 921600 cause issues even when CTS/RTS is enabled
+const int LTE_BAUDRATE            =      115200;  //!< baudrate used for detection, higher baudrates are negotiated and verified, see LTE_BAUDRATES
+const long LTE_BAUDRATES[]        = { 921600, 460800, 230400 }; //!< higher baudrates tried (needs CTS/RTS), the first one passing the loopback burst is used
+const int LTE_BAUDTEST_SIZE       =        1024;  //!< size of the loopback burst used to verify a baudrate
 
 const char* LTE_TASK_NAME         =       "Lte";  //!< Lte task name
 const int LTE_STACK_SIZE          =      4*1024;  //!< Lte task stack size
@@ -65,6 +82,9 @@ const int LTE_TASK_CORE           =           1;  //!< Lte task MCU code
 #define LTE_CHECK(x)              if (SARA_R5_SUCCESS == _err) _step = x, _err            //!< interim evaluate
 #define LTE_CHECK_EVAL(txt)       if (SARA_R5_SUCCESS != _err) log_e(txt ", AT sequence failed at step %d with error %d", _step, _err) //!< final verdict and log_e report
   
+//! the configuration groups that are cached by the LTE task, a change will force a reconnect of the correction client
+const uint32_t LTE_CONFIG_GROUPS = CONFIG::GROUP_SOURCE | CONFIG::GROUP_MQTT | CONFIG::GROUP_NTRIP;
+
 extern class LTE Lte; //!< Forward declaration of class
 
 /** This class encapsulates all LTE functions. 
@@ -80,6 +100,20 @@ public:
     state = INIT;
     restart = false;
     ntripSocket = -1;
+    ntripTtagDrain = millis();
+    ntripDirect = ntripDirectClosed = false;
+    ntripTtagDirect = millis();
+    retryDelay = LTE_BACKOFF_MIN;
+    retries = 0;
+    ttagLost = 0;
+    memset(recoveryHist, 0, sizeof(recoveryHist));
+    ntripDisconnect = 0;
+    configGeneration = Config.getGeneration(LTE_CONFIG_GROUPS) - 1; // force reading the configuration
+    connectGeneration = configGeneration;
+    topicsGeneration = Config.getTopicsGeneration() - 1;
+    ttagMqttCmd = ttagMqttLogin = millis();
+    mqttSynced = mqttFirstData = mqttStopping = false;
+    mqttBackoff = LTE_BACKOFF_MIN;
     hwInit();
   }
 
@@ -96,9 +130,19 @@ protected:
   // -----------------------------------------------------------------------
 
   std::vector<String> topics; //!< vector with current subscribed topics
+  uint32_t topicsGeneration;  //!< the generation of the topic set that topics is in sync with
   String subTopic;            //!< requested topic to be subscribed (needed by the callback) 
   String unsubTopic;          //!< requested topic to be un-subscribed (needed by the callback)
+  int32_t ttagMqttCmd;        //!< time tag (millis()) when the pending subscribe / unsubscribe times out
   int mqttMsgs;               //!< remember the number of messages pending indicated by the URC
+  uint8_t mqttBuf[MQTT_MAX_MSG_SIZE]; //!< persistent read buffer, avoids our own allocation of the max message size for each read
+  String mqttTopic;           //!< persistent topic of the read, keeps its capacity between reads
+  String mqttProfile;         //!< fingerprint of the credentials the security profile was configured with since power on
+  int32_t ttagMqttLogin;      //!< time tag (millis()) of the MQTT login, used to measure the time to the first correction
+  bool mqttSynced;            //!< the topics were in sync since the login
+  bool mqttFirstData;         //!< the first correction was received since the login
+  bool mqttStopping;          //!< we requested the logout, it is not a connection loss
+  int32_t mqttBackoff;        //!< the backoff delay of the pending login, used if the login URC reports an error
 
   //! this helper deals with some AT commands that are not yet implemted in LENA-R8 and throw a warning
   SARA_R5_error_t LTE_IGNORE_LENA(SARA_R5_error_t err) { 
@@ -110,11 +154,15 @@ protected:
   }
   
   /** Try to provision the PointPerfect to that we can start the MQTT server. This involves: 
-   *  1) HTTPS request is made to AWS to GET theri ROOT CA
+   *  1) HTTPS request is made to AWS to GET theri ROOT CA, skipped if the AWSTRUST_ROOTCA is bundled
    *  2) HTTPS request to Thingstream POSTing the device tocken to get the credentials and client cert, key and ID
+   *  The steps are chained by the HTTP callback, so it all completes in a single pass. 
    */
   void mqttProvision(void) {
-    String rootCa = Config.getValue(CONFIG_VALUE_ROOTCA);
+    String rootCa = Config.getValue(CONFIG::KEY_ROOTCA);
+    if (0 == rootCa.length()) {
+      rootCa = AWSTRUST_ROOTCA;
+    }
     if (0 == rootCa.length()) {
       log_i("HTTP AWS connect to \"%s:%d\" and GET \"%s\"", AWSTRUST_SERVER, HTTPS_PORT, AWSTRUST_ROOTCAPATH);
       setHTTPCommandCallback(httpCallbackStatic); // callback will advance state
@@ -157,43 +205,112 @@ protected:
     }
   }
 
+  /** Query the MD5 of a certificate or key stored in the security manager of the modem 
+   *  \param type  the type, e.g. SARA_R5_SEC_MANAGER_ROOTCA 
+   *  \param name  the internal name used when importing it
+   *  \return      the MD5 hex string or an empty string if not stored or not supported
+   */
+  String secMd5(int type, const char* name) {
+    char cmd[48];
+    char resp[128] = "";
+    char md5[33] = "";
+    snprintf(cmd, sizeof(cmd), "+USECMNG=4,%d,\"%s\"", type, name);
+    if (SARA_R5_SUCCESS == sendCustomCommandWithResponse(cmd, "OK", resp, LTE_SECMNG_TIMEOUT)) {
+      // +USECMNG: 4,<type>,"<name>","<md5>"
+      const char* p = strstr(resp, "+USECMNG:");
+      if (NULL != p) {
+        sscanf(p, "+USECMNG: %*d,%*d,\"%*[^\"]\",\"%32[0-9a-fA-F]\"", md5);
+      }
+    }
+    return md5;
+  }
+
+  /** Calculate a fingerprint of the credentials we want to use and the credentials the modem holds. 
+   *  \param broker  the broker used as SNI
+   *  \param rootCa  the root CA
+   *  \param cert    the client certificate
+   *  \param key     the client key
+   *  \return        the fingerprint or an empty string if the modem does not hold all credentials
+   */
+  String mqttFingerprint(const String& broker, const String& rootCa, const String& cert, const String& key) {
+    String md5RootCa = secMd5(SARA_R5_SEC_MANAGER_ROOTCA,      SEC_ROOT_CA);
+    String md5Cert   = secMd5(SARA_R5_SEC_MANAGER_CLIENT_CERT, SEC_CLIENT_CERT);
+    String md5Key    = secMd5(SARA_R5_SEC_MANAGER_CLIENT_KEY,  SEC_CLIENT_KEY);
+    if ((0 == md5RootCa.length()) || (0 == md5Cert.length()) || (0 == md5Key.length())) {
+      return "";
+    }
+    MD5Builder md5;
+    md5.begin();
+    md5.add(broker);
+    md5.add(rootCa);
+    md5.add(cert);
+    md5.add(key);
+    md5.add(md5RootCa);
+    md5.add(md5Cert);
+    md5.add(md5Key);
+    md5.calculate();
+    return md5.toString();
+  }
+
   /** Connect to the Thingstream PointPerfect server using the credentials from ZTP process
    *  \param id  the client ID for this device
+   *  \return    true if the login was requested, the callback will advance the state
    */
-  void mqttConnect(String id) {
-    String rootCa = Config.getValue(CONFIG_VALUE_ROOTCA);
-    String broker = Config.getValue(CONFIG_VALUE_BROKERHOST);
-    String cert = Config.getValue(CONFIG_VALUE_CLIENTCERT);
-    String key = Config.getValue(CONFIG_VALUE_CLIENTKEY);
+  bool mqttConnect(String id) {
+    String rootCa = Config.getValue(CONFIG::KEY_ROOTCA);
+    String broker = Config.getValue(CONFIG::KEY_BROKERHOST);
+    String cert = Config.getValue(CONFIG::KEY_CLIENTCERT);
+    String key = Config.getValue(CONFIG::KEY_CLIENTKEY);
     // disconncect must fail here, so that we can connect 
     setMQTTCommandCallback(mqttCallbackStatic); // callback will advance state
     // make sure the client is disconnected here
     if (SARA_R5_SUCCESS == disconnectMQTT()) {
       log_i("forced disconnect"); // if this sucessful it means were were still connected. 
+      return false; // the next attempt will connect
     } else {
       log_i("connect to \"%s:%d\" as client \"%s\"", broker.c_str(), MQTT_BROKER_PORT, id.c_str());
+      // the credentials are only imported if they changed or the modem does not hold them, 
+      // the security profile is only configured once after power on or if the credentials changed
+      String fingerprint = mqttFingerprint(broker, rootCa, cert, key);
+      bool importOk = (0 < fingerprint.length()) && Config.equals(CONFIG::KEY_LTECERTS, fingerprint.c_str());
+      bool profileOk = importOk && fingerprint.equals(mqttProfile);
+      log_i("credentials %s, security profile %s", importOk ? "unchanged" : "import", profileOk ? "unchanged" : "configure");
       LTE_CHECK_INIT;
-      LTE_CHECK(1)  = setSecurityManager(SARA_R5_SEC_MANAGER_OPCODE_IMPORT, SARA_R5_SEC_MANAGER_ROOTCA,         SEC_ROOT_CA,     rootCa);
-      LTE_CHECK(2)  = setSecurityManager(SARA_R5_SEC_MANAGER_OPCODE_IMPORT, SARA_R5_SEC_MANAGER_CLIENT_CERT,    SEC_CLIENT_CERT, cert);
-      LTE_CHECK(3)  = setSecurityManager(SARA_R5_SEC_MANAGER_OPCODE_IMPORT, SARA_R5_SEC_MANAGER_CLIENT_KEY,     SEC_CLIENT_KEY,  key);
-      LTE_CHECK(4)  = LTE_IGNORE_LENA( resetSecurityProfile(LTE_SEC_PROFILE_MQTT) );
-      LTE_CHECK(5)  = configSecurityProfile(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_CERT_VAL_LEVEL,     SARA_R5_SEC_PROFILE_CERTVAL_OPCODE_YESNOURL);
-      LTE_CHECK(6)  = configSecurityProfile(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_TLS_VER,            SARA_R5_SEC_PROFILE_TLS_OPCODE_VER1_2);
-      LTE_CHECK(7)  = configSecurityProfile(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_CYPHER_SUITE,       SARA_R5_SEC_PROFILE_SUITE_OPCODE_PROPOSEDDEFAULT);
-      LTE_CHECK(8)  = configSecurityProfileString(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_ROOT_CA,      SEC_ROOT_CA);
-      LTE_CHECK(9)  = configSecurityProfileString(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_CLIENT_CERT,  SEC_CLIENT_CERT);
-      LTE_CHECK(10) = configSecurityProfileString(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_CLIENT_KEY,   SEC_CLIENT_KEY);
-      LTE_CHECK(11) = configSecurityProfileString(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_SNI,          broker);
+      if (!importOk) {
+        LTE_CHECK(1)  = setSecurityManager(SARA_R5_SEC_MANAGER_OPCODE_IMPORT, SARA_R5_SEC_MANAGER_ROOTCA,         SEC_ROOT_CA,     rootCa);
+        LTE_CHECK(2)  = setSecurityManager(SARA_R5_SEC_MANAGER_OPCODE_IMPORT, SARA_R5_SEC_MANAGER_CLIENT_CERT,    SEC_CLIENT_CERT, cert);
+        LTE_CHECK(3)  = setSecurityManager(SARA_R5_SEC_MANAGER_OPCODE_IMPORT, SARA_R5_SEC_MANAGER_CLIENT_KEY,     SEC_CLIENT_KEY,  key);
+      }
+      if (!profileOk) {
+        LTE_CHECK(4)  = LTE_IGNORE_LENA( resetSecurityProfile(LTE_SEC_PROFILE_MQTT) );
+        LTE_CHECK(5)  = configSecurityProfile(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_CERT_VAL_LEVEL,     SARA_R5_SEC_PROFILE_CERTVAL_OPCODE_YESNOURL);
+        LTE_CHECK(6)  = configSecurityProfile(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_TLS_VER,            SARA_R5_SEC_PROFILE_TLS_OPCODE_VER1_2);
+        LTE_CHECK(7)  = configSecurityProfile(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_CYPHER_SUITE,       SARA_R5_SEC_PROFILE_SUITE_OPCODE_PROPOSEDDEFAULT);
+        LTE_CHECK(8)  = configSecurityProfileString(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_ROOT_CA,      SEC_ROOT_CA);
+        LTE_CHECK(9)  = configSecurityProfileString(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_CLIENT_CERT,  SEC_CLIENT_CERT);
+        LTE_CHECK(10) = configSecurityProfileString(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_CLIENT_KEY,   SEC_CLIENT_KEY);
+        LTE_CHECK(11) = configSecurityProfileString(LTE_SEC_PROFILE_MQTT, SARA_R5_SEC_PROFILE_PARAM_SNI,          broker);
+      }
       LTE_CHECK(12) = nvMQTT(SARA_R5_MQTT_NV_RESTORE);
       LTE_CHECK(13) = setMQTTclientId(id);
       LTE_CHECK(14) = setMQTTserver(broker, MQTT_BROKER_PORT);
       LTE_CHECK(15) = setMQTTsecure(true, LTE_SEC_PROFILE_MQTT);
       LTE_CHECK(16) = connectMQTT();
       LTE_CHECK_EVAL("setup and connect");
+      if (LTE_CHECK_OK && !importOk) {
+        // remember what the modem holds now, so that we can skip the import next time
+        fingerprint = mqttFingerprint(broker, rootCa, cert, key);
+        if (Config.setValue(CONFIG::KEY_LTECERTS, fingerprint)) {
+          Config.save();
+        }
+      }
+      mqttProfile = LTE_CHECK_OK ? fingerprint : "";
       mqttMsgs = 0;
       topics.clear();
+      topicsGeneration = Config.getTopicsGeneration() - 1; // force subscribing after connect
       subTopic = "";
       unsubTopic = "";
+      return LTE_CHECK_OK;
     }
   }
 
@@ -204,12 +321,50 @@ protected:
     SARA_R5_error_t err = disconnectMQTT();
     if (SARA_R5_SUCCESS == err) {
       log_i("disconnect");
+      mqttStopping = true;
     } else {
       log_e("disconnect, failed with error %d", err);
     }
     return SARA_R5_SUCCESS != err;
   }
   
+  /** Build the list of topic filters to subscribe, where possible the correction topics of a region 
+   *  are combined into a single wildcard filter, this saves several subscribe round trips. 
+   *  \param topics  the topics from the configuration
+   *  \param filters  the filters to subscribe, in the same order as topics
+   */
+  void mqttFilters(const std::vector<String>& topics, std::vector<String>& filters) {
+    bool wildcard = LTE_MQTT_WILDCARD && !module.startsWith("LENA-R8");
+    const char* subTopics[] = { MQTT_TOPIC_IP_GAD, MQTT_TOPIC_IP_HPAC, MQTT_TOPIC_IP_OCB, MQTT_TOPIC_IP_CLK };
+    filters.clear();
+    for (auto it = topics.begin(); it != topics.end(); it = std::next(it)) {
+      String filter = *it;
+      for (int i = 0; wildcard && (i < sizeof(subTopics)/sizeof(*subTopics)); i ++) {
+        if (filter.endsWith(subTopics[i])) {
+          filter = filter.substring(0, filter.length() - strlen(subTopics[i])) + "/+";
+          break;
+        }
+      }
+      if (filters.end() == std::find(filters.begin(), filters.end(), filter)) {
+        filters.push_back(filter);
+      }
+    }
+  }
+
+  /** Check if a topic is covered by a subscribed topic filter, only the single level wildcard '+' 
+   *  at the end of the filter is supported as this is what mqttFilters generates. 
+   *  \param filter  the topic filter
+   *  \param topic   the topic of a message
+   *  \return        true if the topic is covered by the filter
+   */
+  static bool mqttMatch(const String& filter, const String& topic) {
+    if (filter.endsWith("/+")) {
+      int len = filter.length() - 1;
+      return topic.startsWith(filter.substring(0, len)) && (-1 == topic.indexOf('/', len));
+    }
+    return filter.equals(topic);
+  }
+
   /** The MQTT task is responsible for:
    *  1) subscribing to topics
    *  2) unsubscribing from topics 
@@ -217,15 +372,26 @@ protected:
    */
   void mqttTask(void) {
     /* The LTE modem has difficulties subscribing/unsubscribing more than one topic at the same time
-     * We can only start one operation at a time wait for the URC and add a extra delay before we can 
-     * do the next operation.
+     * We can only start one operation at a time and wait for the URC. The callback schedules the next 
+     * operation with just a short extra delay, so that the topics are pipelined as fast as the modem allows. 
      */
+    int32_t now = millis();
     bool busy = (0 < subTopic.length()) || (0 < unsubTopic.length());
-    if (!busy) {
-      std::vector<String> newTopics = Config.getTopics();
+    if (busy && (0 >= (ttagMqttCmd - now))) {
+      log_w("no response for %s topic \"%s\", retry", subTopic.length() ? "subscribe" : "unsubscribe", 
+            subTopic.length() ? subTopic.c_str() : unsubTopic.c_str());
+      subTopic = "";
+      unsubTopic = "";
+      busy = false;
+    }
+    if (!busy && (topicsGeneration != Config.getTopicsGeneration())) {
+      uint32_t generation;
+      std::shared_ptr<const std::vector<String>> configTopics = Config.getTopics(&generation);
+      std::vector<String> newTopics;
+      mqttFilters(*configTopics, newTopics);
       // loop through new topics and subscribe to the first topic that is not in our curent topics list. 
       for (auto it = newTopics.begin(); (it != newTopics.end()) && !busy; it = std::next(it)) {
-        String topic = *it;
+        const String& topic = *it;
         std::vector<String>::iterator pos = std::find(topics.begin(), topics.end(), topic);
         if (pos == topics.end()) {
           SARA_R5_error_t err = subscribeMQTTtopic(0,topic);
@@ -241,7 +407,7 @@ protected:
       // loop through current topics and unsubscribe to the first topic that is not in the new topics list. 
       for (auto it = topics.begin(); (it != topics.end()) && !busy; it = std::next(it)) {
         String topic = *it;
-        std::vector<String>::iterator pos = std::find(newTopics.begin(), newTopics.end(), topic);
+        std::vector<String>::const_iterator pos = std::find(newTopics.begin(), newTopics.end(), topic);
         if (pos == newTopics.end()) {
           SARA_R5_error_t err = unsubscribeMQTTtopic(topic);
           if (SARA_R5_SUCCESS == err) {
@@ -253,54 +419,75 @@ protected:
           busy = true;
         }
       }
+      if (busy) {
+        // the URC will schedule the next operation, but don't wait forever
+        ttagMqttCmd = now + LTE_MQTTCMD_TIMEOUT;
+        ttagNextTry = ttagMqttCmd;
+      } else {
+        // nothing left to do, we are in sync with this topic set 
+        topicsGeneration = generation;
+        if (!mqttSynced) {
+          mqttSynced = true;
+          log_i("%d topics subscribed %d ms after login", topics.size(), now - ttagMqttLogin);
+        }
+      }
+    }
+    if (!busy) {
       if (!busy && (0 < mqttMsgs)) {
         // at this point we are properly subscribed to the needed topics and can now read data
         log_d("read request %d msg", mqttMsgs);
-        // The MQTT API does not allow getting the size before actually reading the data. So we 
-        // have to allocate a big enough buffer. PointPerfect may send upto 9kB on the MGA topic.
-        uint8_t *buf = new uint8_t[MQTT_MAX_MSG_SIZE];
-        if (buf != NULL) {
-          String topic;
-          int len = -1;
-          int qos = -1;
-          SARA_R5_error_t err = readMQTT(&qos, &topic, buf, MQTT_MAX_MSG_SIZE, &len);
-          if (SARA_R5_SUCCESS == err) {
-            mqttMsgs = 0; // expect a URC afterwards
-            const char* strTopic = topic.c_str();
-            log_i("topic \"%s\" read %d bytes", strTopic, len);
-            GNSS::SOURCE source = GNSS::SOURCE::LTE;
-            if (topic.startsWith(MQTT_TOPIC_KEY_FORMAT)) {
-              source = GNSS::SOURCE::KEYS;
-              if (Config.setValue(CONFIG_VALUE_KEY, buf, len)) {
-                Config.save();
-              }
+        // The MQTT API does not allow getting the size before actually reading the data, the URC only 
+        // reports the number of messages. So we read into the persistent buffer that is big enough for 
+        // any message, PointPerfect may send upto 9kB on the MGA topic. Note that readMQTT() still 
+        // allocates a response buffer of this size plus some overhead for each read in the library, 
+        // and inject() copies the payload into the GNSS chunk pool, only our own allocation is gone.
+        uint8_t* buf = mqttBuf;
+        String& topic = mqttTopic;
+        int len = -1;
+        int qos = -1;
+        SARA_R5_error_t err = readMQTT(&qos, &topic, buf, sizeof(mqttBuf), &len);
+        if (SARA_R5_SUCCESS == err) {
+          mqttMsgs = 0; // expect a URC afterwards
+          const char* strTopic = topic.c_str();
+          log_i("topic \"%s\" read %d bytes", strTopic, len);
+          GNSS::SOURCE source = GNSS::SOURCE::LTE;
+          if (topic.startsWith(MQTT_TOPIC_KEY_FORMAT)) {
+            source = GNSS::SOURCE::KEYS;
+            if (Config.setValue(CONFIG::KEY_PPKEY, buf, len)) {
+              Config.save();
             }
-            // if we detect data from a topic, then why not unsubscribe from it. 
-            std::vector<String>::iterator pos = std::find(topics.begin(), topics.end(), topic);
-            if (pos == Lte.topics.end()) {
-              log_e("getting data from an unexpected topic \"%s\"", strTopic);
-              if (!busy) {
-                err = unsubscribeMQTTtopic(topic);
-                if (SARA_R5_SUCCESS == err) {
-                  log_d("unsubscribe requested for unexpected topic \"%s\"", strTopic);
-                  unsubTopic = topic;
-                } else {
-                  log_e("unsubscribe request for unexpected topic \"%s\", failed with error %d", topic.c_str(), err);
-                }
-                busy = true;
+          }
+          // if we detect data from a topic, then why not unsubscribe from it. 
+          std::vector<String>::iterator pos = topics.begin();
+          while ((pos != topics.end()) && !mqttMatch(*pos, topic)) {
+            pos = std::next(pos);
+          }
+          if (pos == topics.end()) {
+            log_e("getting data from an unexpected topic \"%s\"", strTopic);
+            if (!busy) {
+              err = unsubscribeMQTTtopic(topic);
+              if (SARA_R5_SUCCESS == err) {
+                log_d("unsubscribe requested for unexpected topic \"%s\"", strTopic);
+                unsubTopic = topic;
+                ttagMqttCmd = millis() + LTE_MQTTCMD_TIMEOUT;
+              } else {
+                log_e("unsubscribe request for unexpected topic \"%s\", failed with error %d", topic.c_str(), err);
               }
-            } else if (topic.equals(MQTT_TOPIC_FREQ)) {
-              // Do not inject this json data to GNSS but extract the LBAND frequencies
-              Config.setLbandFreqs(buf, (size_t)len); 
-            } else {
-              // anything else can be sent to the GNSS as is
-              len = Gnss.inject(buf, (size_t)len, source);
+              busy = true;
             }
+          } else if (topic.equals(MQTT_TOPIC_FREQ)) {
+            // Do not inject this json data to GNSS but extract the LBAND frequencies
+            Config.setLbandFreqs(buf, (size_t)len); 
           } else {
-            log_e("read failed with error %d", err);
+            // anything else can be sent to the GNSS as is, inject copies it into the chunk pool of the GNSS
+            len = Gnss.inject(buf, (size_t)len, source);
+            if (!mqttFirstData && (source == GNSS::SOURCE::LTE) && !topic.startsWith(MQTT_TOPIC_MGA)) {
+              mqttFirstData = true;
+              log_i("first correction topic \"%s\" %d ms after login", strTopic, millis() - ttagMqttLogin);
+            }
           }
-          // we need to free the buffer, as the inject function took a copy with only the required size
-          delete [] buf;
+        } else {
+          log_e("read failed with error %d", err);
         }
       }
     }
@@ -311,14 +498,18 @@ protected:
    *  \param request  the response code 1 = sucess, 0 = error
    */
   void mqttCallback(int command, int result) {
-    log_d("%d command %d result %d", command, result);
+    log_d("command %d result %d", command, result);
     if (result == 0) {
       int code, code2;
       SARA_R5_error_t err = getMQTTprotocolError(&code, &code2);
       if (SARA_R5_SUCCESS == err) {
         log_e("command %d protocol error code %d code2 %d", command, code, code2);  
       } else {
-        log_e("command %d protocol error failed with error", command, err);
+        log_e("command %d protocol error failed with error %d", command, err);
+      }
+      if ((command == SARA_R5_MQTT_COMMAND_LOGIN) && (state == ONLINE)) {
+        // no need to wait for the login timeout, retry with the backoff
+        ttagNextTry = millis() + mqttBackoff;
       }
     } else { 
       switch (command) {
@@ -327,6 +518,10 @@ protected:
             log_e("login wrong state");
           } else {
             log_i("login");
+            ttagMqttLogin = millis();
+            mqttSynced = false;
+            mqttFirstData = false;
+            mqttStopping = false;
             setState(MQTT, LTE_MQTTCMD_DELAY);
           }
           break;
@@ -335,8 +530,13 @@ protected:
             log_e("logout wrong state");
           } else {
             log_i("logout");
+            if (!mqttStopping) {
+              lost();
+            }
+            mqttStopping = false;
             mqttMsgs = 0;
             topics.clear();
+            topicsGeneration = Config.getTopicsGeneration() - 1;
             subTopic = "";
             unsubTopic = "";
             setState(ONLINE, LTE_MQTTCMD_DELAY);
@@ -419,12 +619,15 @@ protected:
         if (offset) {
           str.remove(0, offset + sizeof(START_TAG) - 1);
           if (command == SARA_R5_HTTP_COMMAND_GET) {
-            // save the AWS root CA
-            Config.setValue(CONFIG_VALUE_ROOTCA, str);
-            setState(ONLINE);
+            // save the AWS root CA and continue with the ZTP request right away
+            Config.setValue(CONFIG::KEY_ROOTCA, str);
+            mqttProvision();
           } else if (command == SARA_R5_HTTP_COMMAND_POST_FILE) {
-            // save the ZTP
-            String rootCa = Config.getValue(CONFIG_VALUE_ROOTCA);
+            // save the ZTP, no need to wait for the provisioning retry to connect
+            String rootCa = Config.getValue(CONFIG::KEY_ROOTCA);
+            if (0 == rootCa.length()) {
+              rootCa = AWSTRUST_ROOTCA;
+            }
             String id = Config.setZtp(str, rootCa);
             setState(ONLINE);
           }
@@ -443,6 +646,12 @@ protected:
 
   int32_t ntripGgaMs;  //!< time tag (millis()) of next GGA to be sent
   int ntripSocket = -1;     //!< the socket handle 
+  int32_t ntripTtagDrain;   //!< time tag (millis()) when the socket is drained manually if no URC indicated data
+  char ntripBuf[LTE_NTRIP_READ_SIZE]; //!< reusable buffer for draining the socket and the direct link
+  bool ntripDirect;         //!< the socket is in direct link mode, the UART carries the raw stream 
+  int32_t ntripTtagDirect;  //!< time tag (millis()) when the direct link times out if no data is received
+  int ntripDisconnect;      //!< number of characters matched of the DISCONNECT message ending the direct link
+  bool ntripDirectClosed;   //!< the remote side closed the socket and the modem left the direct link mode
 
   /** Connect to a NTRIP server
    *  \param url  the proto://server:port/mountpoint to connect to
@@ -485,10 +694,10 @@ protected:
       LTE_CHECK_EVAL("connect");
       if (LTE_CHECK_OK) {
         // get request
-        String user = Config.getValue(CONFIG_VALUE_NTRIP_USERNAME);
-        String pwd = Config.getValue(CONFIG_VALUE_NTRIP_PASSWORD);
-        String ver = Config.getValue(CONFIG_VALUE_NTRIP_VERSION);
-        String gga = Config.getValue(CONFIG_VALUE_NTRIP_GGA);
+        String user = Config.getValue(CONFIG::KEY_NTRIP_USERNAME);
+        String pwd = Config.getValue(CONFIG::KEY_NTRIP_PASSWORD);
+        String ver = Config.getValue(CONFIG::KEY_NTRIP_VERSION);
+        String gga = Config.getValue(CONFIG::KEY_NTRIP_GGA);
         String auth;
         if (0 < user.length() && 0 < pwd.length()) {
           auth = base64::encode(user + ":" + pwd);
@@ -533,12 +742,18 @@ protected:
                   const char* pOk = &buf[len - iOk];             
                   if (0 == memcmp(pOk, NTRIP_RESPONSE_HTTPOK, iOk)) {
                     log_i("url \"%s\" user \"%s\" pwd \"%s\" ver \"%s\" connected", 
-                          url.c_str(), user.c_str(), pwd.c_str(), ver);
+                          url.c_str(), user.c_str(), pwd.c_str(), ver.c_str());
                     ntripGgaMs = millis();
+                    // pick up anything that arrived with the reply
+                    ntripDrain();
+                    if (!LTE_NTRIP_DIRECTLINK || !ntripDirectStart()) {
+                      // from now on the data is delivered by the +UUSORD URC
+                      setSocketReadCallbackPlus(ntripReadCallbackStatic);
+                    }
                     return true;
                   } else {
                     log_e("url \"%s\" user \"%s\" pwd \"%s\" ver \"%s\" failed, reply \"%.*s\"", 
-                          url.c_str(), user.c_str(), pwd.c_str(), ver, read, buf);
+                          url.c_str(), user.c_str(), pwd.c_str(), ver.c_str(), read, buf);
                   }
                 } else {
                   log_e("reply avail %d len %d reply %d \"%.*s\"", 
@@ -566,6 +781,9 @@ protected:
    */
   void ntripStop(void) {
     if (ntripSocket >= 0) {
+      if (ntripDirect || ntripDirectClosed) {
+        ntripDirectExit();
+      }
       SARA_R5_error_t err = socketClose(ntripSocket);
       if (err == SARA_R5_SUCCESS) {
         log_i("disconnected");
@@ -576,43 +794,165 @@ protected:
     }
   }
 
+  /** The socket read callback is called from the +UUSORD URC, the library already read the data 
+   *  so that it can be injected into the GNSS receiver without delay. The library only reads if a 
+   *  callback is installed and it allocates a response buffer for each of these reads. 
+   *  \param socket  the socket handle
+   *  \param data    the data read
+   *  \param len     the number of bytes read
+   *  \param ip      the remote address (unused)
+   *  \param port    the remote port (unused)
+   */
+  void ntripReadCallback(int socket, const char* data, int len, IPAddress ip, int port) {
+    if ((state == NTRIP) && (socket == ntripSocket) && (0 < len)) {
+      log_i("read %d bytes", len);
+      Gnss.inject((const uint8_t*)data, len, GNSS::SOURCE::LTE);
+      ntripTtagDrain = millis() + LTE_NTRIP_DRAIN_TIMEOUT;
+    }
+  }
+  //! static callback helper, ntripReadCallback will do the real work
+  static void ntripReadCallbackStatic(int socket, const char* data, int len, IPAddress ip, int port) {
+    Lte.ntripReadCallback(socket, data, len, ip, port);
+  }
+
+  /** Read everything that is pending on the socket in chunks of the reusable buffer and inject it 
+   *  into the GNSS receiver. socketRead() still allocates its response buffer for each chunk. 
+   */
+  void ntripDrain(void) {
+    int avail = 0;
+    LTE_CHECK_INIT;
+    LTE_CHECK(1) = socketReadAvailable(ntripSocket, &avail);
+    while (LTE_CHECK_OK && (0 < avail)) {
+      int len = (avail < sizeof(ntripBuf)) ? avail : sizeof(ntripBuf);
+      int read = 0;
+      LTE_CHECK(2) = socketRead(ntripSocket, len, ntripBuf, &read);
+      if (LTE_CHECK_OK && (0 < read)) {
+        log_i("read %d bytes", read);
+        Gnss.inject((const uint8_t*)ntripBuf, read, GNSS::SOURCE::LTE);
+        avail -= read;
+        if (0 >= avail) {
+          // check if more arrived in the meantime
+          LTE_CHECK(3) = socketReadAvailable(ntripSocket, &avail);
+        }
+      } else {
+        avail = 0;
+      }
+    }
+    LTE_CHECK_EVAL("read");
+    ntripTtagDrain = millis() + LTE_NTRIP_DRAIN_TIMEOUT;
+  }
+
+  /** Switch the socket into direct link mode, the modem will then stream the raw data over the UART. 
+   *  \return  true if direct link mode was entered 
+   */
+  bool ntripDirectStart(void) {
+    LTE_CHECK_INIT;
+    LTE_CHECK(1) = socketDirectLinkTimeTrigger(ntripSocket, LTE_DIRECTLINK_TRIGGER);
+    LTE_CHECK(2) = socketDirectLinkMode(ntripSocket);
+    LTE_CHECK_EVAL("direct link");
+    ntripDirect = LTE_CHECK_OK;
+    if (ntripDirect) {
+      log_i("direct link mode");
+      ntripDisconnect = 0;
+      ntripDirectClosed = false;
+      ntripTtagDirect = millis() + LTE_DIRECTLINK_TIMEOUT;
+    }
+    return ntripDirect;
+  }
+
+  /** Leave the direct link mode using the escape sequence, the socket remains open. 
+   */
+  void ntripDirectExit(void) {
+    if (!ntripDirectClosed) {
+      // the escape sequence needs a silent guard time before and after 
+      vTaskDelay(LTE_DIRECTLINK_GUARD);
+      UbxSerial.write((const uint8_t*)"+++", 3);
+      vTaskDelay(LTE_DIRECTLINK_GUARD);
+    }
+    // drop anything left of the stream
+    while (0 < UbxSerial.available()) {
+      UbxSerial.read();
+    }
+    ntripDirect = false;
+    ntripDirectClosed = false;
+    SARA_R5_error_t err = at();
+    if (SARA_R5_SUCCESS == err) {
+      log_i("direct link mode left");
+    } else {
+      log_e("direct link mode left, AT failed with error %d", err);
+    }
+  }
+
+  /** In direct link mode read the raw stream from the UART and inject it into the GNSS receiver. The 
+   *  DISCONNECT message of the modem is detected, it indicates that the remote side closed the socket. 
+   */
+  void ntripDirectRead(void) {
+    const char DISCONNECT[] = "\r\nDISCONNECT\r\n";
+    // the bytes that matched the start of DISCONNECT were held back by the last read, put them in front
+    int len = ntripDisconnect;
+    memcpy(ntripBuf, DISCONNECT, len);
+    const int held = len;
+    int end = -1;
+    while ((len < sizeof(ntripBuf)) && (0 < UbxSerial.available())) {
+      char ch = UbxSerial.read();
+      ntripBuf[len++] = ch;
+      ntripDisconnect = (ch == DISCONNECT[ntripDisconnect]) ? ntripDisconnect + 1 : (ch == DISCONNECT[0]) ? 1 : 0;
+      if (ntripDisconnect == sizeof(DISCONNECT) - 1) {
+        log_i("direct link disconnected");
+        ntripDirectClosed = true; // the modem is back in command mode, no need to escape
+        ntripDirect = false;
+        ntripDisconnect = 0;
+        end = len - (sizeof(DISCONNECT) - 1);
+        break;
+      }
+    }
+    // only the data before DISCONNECT (or a possible start of it) goes to the GNSS
+    int size = (0 <= end) ? end : len - ntripDisconnect;
+    if (0 < size) {
+      log_d("read %d bytes", size);
+      Gnss.inject((const uint8_t*)ntripBuf, size, GNSS::SOURCE::LTE);
+    }
+    if (ntripDirect && (len > held)) {
+      ntripTtagDirect = millis() + LTE_DIRECTLINK_TIMEOUT;
+    }
+  }
+
   /** The NTRIP task is responsible for:
-   *  1) reading NTRIP data from the modem and inject it into the GNSS receiver.
+   *  1) draining the socket in case the +UUSORD URC was missed, normally the URC delivers the data. 
    *  2) sending a GGA from time to time to allow VRS services to adjust their correction stream 
    */
   void ntripTask(void) {
     if (ntripSocket >= 0) {
-      int messageSize = 0;
-      LTE_CHECK_INIT;
-      LTE_CHECK(1) = socketReadAvailable(ntripSocket, &messageSize);
-      if (LTE_CHECK_OK && (0 < messageSize)) {
-        GNSS::MSG msg;
-        msg.data = new uint8_t[messageSize];
-        if (NULL != msg.data) {
-          int readSize = 0;
-          LTE_CHECK(2) = socketRead(ntripSocket, messageSize, (char*)msg.data, &readSize);
-          if (LTE_CHECK_OK && (readSize == messageSize)) {
-            msg.size = readSize;
-            msg.source = GNSS::SOURCE::LTE;
-            log_i("read %d bytes", readSize);
-            Gnss.inject(msg);
-          } else {
-            log_e("read %d bytes failed reading after %d", messageSize, readSize); 
-            delete [] msg.data;
-          }
-        } else {
-          log_e("read %d bytes failed, no memory", messageSize);
+      int32_t now = millis();
+      if (ntripDirectClosed) {
+        // the remote side closed the direct link, reconnect
+        lost();
+        ntripStop();
+        setState(ONLINE, LTE_1S_RETRY);
+        return;
+      } else if (ntripDirect) {
+        if (0 >= (ntripTtagDirect - now)) {
+          log_w("direct link no data, reconnect");
+          lost();
+          ntripStop();
+          setState(ONLINE, LTE_1S_RETRY);
+          return;
         }
+      } else if (0 >= (ntripTtagDrain - now)) {
+        ntripDrain();
       }
-      LTE_CHECK_EVAL("read");
       // send the GGA message
-      long now = millis();
       if (ntripGgaMs - now <= 0) {
-        String gga = Config.getValue(CONFIG_VALUE_NTRIP_GGA);
+        String gga = Config.getValue(CONFIG::KEY_NTRIP_GGA);
         int len = gga.length();
         if (0 < len) {
           LTE_CHECK_INIT;
-          LTE_CHECK(1) = socketWrite(ntripSocket, gga + "\r\n");
+          if (ntripDirect) {
+            // the raw data is sent to the socket by the time trigger 
+            UbxSerial.write((const uint8_t*)(gga + "\r\n").c_str(), len + 2);
+          } else {
+            LTE_CHECK(1) = socketWrite(ntripSocket, gga + "\r\n");
+          }
           LTE_CHECK_EVAL("write");
           if (LTE_CHECK_OK) {
             log_i("write \"%s\\r\\n\" %d bytes", gga.c_str(), len + 2);
@@ -633,6 +973,7 @@ protected:
    *  \return  the detection status
    */
   bool lteDetect(void) {
+    mqttProfile = ""; // the modem may have been power cycled, the security profile must be configured again 
     bool ok = hwReady();
     if (ok) {
       module = getModelID();
@@ -659,9 +1000,106 @@ protected:
       if (SARA_R5_ERROR_ERROR == err) {
         log_e("SIM card not found, err %d", err);
       }
+      baudNegotiate();
     }    
     return ok;
   }
+
+  /** get the best verified baudrate from the configuration
+   *  \param mod  the module the baudrate must be verified with, NULL for any 
+   *  \return     the baudrate or 0 if none is stored for this module 
+   */
+  long baudStored(const char* mod) {
+    String value = Config.getValue(CONFIG::KEY_LTEBAUD);
+    int pos = value.lastIndexOf(':');
+    if ((0 < pos) && ((NULL == mod) || value.substring(0, pos).equals(mod))) {
+      return value.substring(pos + 1).toInt();
+    }
+    return 0;
+  }
+
+  /** Step the modem and UART up to the highest baudrate that passes the verification, the result is 
+   *  stored per module type so that the next start only tries the best known baudrate. 
+   */
+  void baudNegotiate(void) {
+    if ((PIN_INVALID == LTE_RTS) || (PIN_INVALID == LTE_CTS)) {
+      return; // higher baudrates need flow control
+    }
+    long best = baudStored(module.c_str());
+    long baud = LTE_BAUDRATE;
+    for (int i = 0; i < sizeof(LTE_BAUDRATES)/sizeof(*LTE_BAUDRATES); i ++) {
+      // skip baudrates above the known good one, they failed before
+      if (((0 == best) || (LTE_BAUDRATES[i] <= best)) && baudTry(LTE_BAUDRATES[i])) {
+        baud = LTE_BAUDRATES[i];
+        break;
+      }
+    }
+    log_i("baudrate %ld", baud);
+    // only store a verified baudrate, storing the default would skip the higher ones on the next start
+    if ((LTE_BAUDRATE != baud) && (baud != best)) {
+      if (Config.setValue(CONFIG::KEY_LTEBAUD, module + ":" + baud)) {
+        Config.save();
+      }
+    }
+  }
+
+  /** switch to a baudrate and verify it with a loopback burst through a file in the modem, on failure 
+   *  the modem and UART are set back to the default baudrate 
+   *  \param baud  the baudrate
+   *  \return      true if the baudrate is working 
+   */
+  bool baudTry(long baud) {
+    // the burst is built on the heap, the LTE task stack is too small to hold it 
+    String data;
+    data.reserve(LTE_BAUDTEST_SIZE);
+    uint32_t seed = micros();
+    for (int i = 0; i < LTE_BAUDTEST_SIZE; i ++) {
+      seed = seed * 1103515245 + 12345;
+      data += (char)(' ' + ((seed >> 16) % 95)); // printable only, the file API uses strings
+    }
+    uint32_t crc = crc32(data.c_str(), data.length());
+    String read;
+    LTE_CHECK_INIT;
+    LTE_CHECK(1) = setBaud(baud);
+    if (LTE_CHECK_OK) {
+      beginSerial(baud); // setBaud only changes the modem, follow with the UART
+    }
+    LTE_CHECK(2) = at();
+    deleteFile(FILE_BAUDTEST); // okay if this fails when file not present
+    LTE_CHECK(3) = appendFileContents(FILE_BAUDTEST, data);
+    LTE_CHECK(4) = getFileContents(FILE_BAUDTEST, &read);
+    deleteFile(FILE_BAUDTEST);
+    bool ok = LTE_CHECK_OK && (read.length() == LTE_BAUDTEST_SIZE) && (crc32(read.c_str(), read.length()) == crc);
+    if (!ok) {
+      log_w("baudrate %ld failed at step %d error %d read %d bytes", baud, _step, _err, read.length());
+      // find the modem at either baudrate and move it back to the default 
+      beginSerial(baud);
+      if (SARA_R5_SUCCESS == at()) {
+        setBaud(LTE_BAUDRATE);
+      }
+      beginSerial(LTE_BAUDRATE);
+      if (SARA_R5_SUCCESS != at()) {
+        log_e("modem lost after baudrate %ld", baud);
+      }
+    }
+    return ok;
+  }
+
+  /** the standard CRC32 used to verify the loopback burst 
+   *  \param data  the data
+   *  \param len   the size of data
+   *  \return      the crc
+   */
+  static uint32_t crc32(const char* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (len --) {
+      crc ^= (uint8_t)*data++;
+      for (int k = 0; k < 8; k ++) {
+        crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+      }
+    }
+    return ~crc;
+  }
   
   /** initialize the LTE modem and report useful information
    *  \return  initialisation process sucess
@@ -671,7 +1109,7 @@ protected:
     LTE_CHECK_INIT;
     LTE_CHECK(1) = getSimStatus(&code); 
     if (LTE_CHECK_OK && code.equals("SIM PIN")) {
-      String pin = Config.getValue(CONFIG_VALUE_SIMPIN);
+      String pin = Config.getValue(CONFIG::KEY_SIMPIN);
       if (pin.length()) {
         LTE_CHECK(2) = setSimPin(pin);
         LTE_CHECK(3) = getSimStatus(&code); // retry get the SIM status
@@ -688,7 +1126,7 @@ protected:
         log_i("IMEI=\"%s\" IMSI=\"%s\" subscriber=\"%s\"", getIMEI().c_str(), getIMSI().c_str(), subNo.c_str());
         // configure the MNO profile 
         if (!module.startsWith("LENA-R8")) {
-          String mno = Config.getValue(CONFIG_VALUE_MNOPROF);
+          String mno = Config.getValue(CONFIG::KEY_MNOPROF);
           if (mno.length()) {
             mobile_network_operator_t eMno = (mobile_network_operator_t)mno.toInt();
             if (!setNetworkProfile(eMno)) {
@@ -701,7 +1139,7 @@ protected:
         LTE_CHECK(1) = setEpsRegistrationCallback(epsRegCallbackStatic);
         LTE_CHECK(2) = setRegistrationCallback(regCallbackStatic);
         // set the APn
-        String apn = Config.getValue(CONFIG_VALUE_LTEAPN);
+        String apn = Config.getValue(CONFIG::KEY_LTEAPN);
         if (apn.length()) {
           LTE_CHECK(3) = setAPN(apn);
         }
@@ -768,6 +1206,41 @@ protected:
     return false;
   }
 
+  /** Fast check if the modem is still registered and the PDP context is still active, this allows 
+   *  to skip the activation and go straight back to connecting after a connection loss. 
+   *  \return  true if registered and the context is active
+   */
+  bool lteAttached(void) {
+    SARA_R5_registration_status_t status = registration(true); // EPS
+    if ((status != SARA_R5_REGISTRATION_HOME) && (status != SARA_R5_REGISTRATION_ROAMING)) {
+      return false;
+    }
+    if (module.startsWith("LARA-R6")) {
+      return true; // activates the context automatically
+    }
+    char resp[256] = "";
+    bool active = false;
+    if (module.startsWith("LENA-R8")) {
+      // +CGACT: <cid>,<state> for each context
+      if (SARA_R5_SUCCESS == sendCustomCommandWithResponse("+CGACT?", "OK", resp, LTE_1S_RETRY)) {
+        for (const char* p = strstr(resp, "+CGACT:"); (NULL != p) && !active; p = strstr(p + 1, "+CGACT:")) {
+          int cid, act;
+          active = (2 == sscanf(p, "+CGACT: %d,%d", &cid, &act)) && (1 == act);
+        }
+      }
+    } else /* SARA-R5 */ {
+      // +UPSND: <profile>,8,<status>
+      char cmd[16];
+      snprintf(cmd, sizeof(cmd), "+UPSND=%d,8", LTE_PSD_PROFILE);
+      if (SARA_R5_SUCCESS == sendCustomCommandWithResponse(cmd, "OK", resp, LTE_1S_RETRY)) {
+        const char* p = strstr(resp, "+UPSND:");
+        int profile, param, act;
+        active = (NULL != p) && (3 == sscanf(p, "+UPSND: %d,%d,%d", &profile, &param, &act)) && (1 == act);
+      }
+    }
+    return active;
+  }
+
   /** evaluate registration status and report it
    *  \param status     the registration status
    *  \param tacLac     the tac or lac 
@@ -783,6 +1256,7 @@ protected:
     if (((status == SARA_R5_REGISTRATION_HOME) || (status == SARA_R5_REGISTRATION_ROAMING)) && (state < REGISTERED)) {
       setState(REGISTERED);
     } else if ((status == SARA_R5_REGISTRATION_SEARCHING) && (state >= REGISTERED)) {
+      lost();
       setState(WAITREGISTER);
     }
   }
@@ -850,8 +1324,8 @@ protected:
    */
   static void psdCallbackStatic(int profile, IPAddress ip) {
     log_d("psdCallback profile %d  IP %s", profile, ip.toString().c_str());
-    if (profile == LTE_PSD_PROFILE) {
-      String id = Config.getValue(CONFIG_VALUE_CLIENTID);
+    // lteActivate() may already have moved on, don't reschedule a connect or provisioning that is in progress
+    if ((profile == LTE_PSD_PROFILE) && (Lte.state < ONLINE)) {
       Lte.setState(ONLINE);
     }
   }
@@ -886,6 +1360,49 @@ protected:
   STATE state;            //!< the current state
   bool restart;
   int32_t ttagNextTry;    //!< time tag when to call the state machine again
+  int32_t retryDelay;     //!< the current delay of the exponential backoff 
+  int retries;            //!< the number of activation or connection attempts in the current state
+  int32_t ttagLost;       //!< time tag (millis()) when the MQTT or NTRIP connection was lost, 0 if not lost
+  //! upper bounds in ms of the recovery time histogram bins, the last bin takes anything longer
+  const int32_t RECOVERY_BINS[6] = { 1000, 2000, 5000, 10000, 30000, 60000 };
+  int recoveryHist[sizeof(RECOVERY_BINS)/sizeof(*RECOVERY_BINS) + 1]; //!< histogram of the connection recovery times
+  
+  /** get the delay of the next attempt and double the backoff delay 
+   *  \return  the delay to use 
+   */
+  int32_t backoff(void) {
+    int32_t delay = retryDelay;
+    retryDelay = (retryDelay < (LTE_BACKOFF_MAX / 2)) ? (retryDelay * 2) : LTE_BACKOFF_MAX;
+    return delay;
+  }
+
+  /** record the time it took to recover a lost connection in the histogram and report it
+   *  \param ms  the recovery time
+   */
+  void recovered(int32_t ms) {
+    const int num = sizeof(recoveryHist)/sizeof(*recoveryHist);
+    int bin = 0;
+    while ((bin < num - 1) && (ms >= RECOVERY_BINS[bin])) {
+      bin ++;
+    }
+    recoveryHist[bin] ++;
+    char buf[128];
+    int len = 0;
+    for (int i = 0; i < num; i ++) {
+      len += snprintf(&buf[len], sizeof(buf) - len, " %s%ds %d", (i < num - 1) ? "<" : ">=", 
+                      RECOVERY_BINS[(i < num - 1) ? i : i - 1] / 1000, recoveryHist[i]);
+    }
+    log_i("connection recovered in %d ms, histogram:%s", ms, buf);
+  }
+
+  /** remember when the MQTT or NTRIP connection was lost, the recovery time is measured from here. 
+   *  Call it only for a real loss, not when switching the service or after a configuration change.
+   */
+  void lost(void) {
+    if ((state >= MQTT) && (0 == ttagLost)) {
+      ttagLost = millis();
+    }
+  }
 
   /** advance the state and report transitions
    *  \param newState  the new state
@@ -894,7 +1411,18 @@ protected:
   void setState(STATE newState, int32_t delay = 0) {
     if (state != newState) {
       log_i("state change %d(%s)", newState, STATE_LUT[newState]);
+      if ((state < MQTT) && (newState >= MQTT) && (0 != ttagLost)) {
+        recovered(millis() - ttagLost);
+        ttagLost = 0;
+      }
+      retryDelay = LTE_BACKOFF_MIN;
+      retries = 0;
       state = newState;
+      if (newState == REGISTERED) {
+        Timeline.mark(TIMELINE::LTE);
+      } else if ((newState == MQTT) || (newState == NTRIP)) {
+        Timeline.mark(TIMELINE::SERVICE);
+      }
     }
     ttagNextTry = millis() + delay; 
   }
@@ -910,6 +1438,7 @@ protected:
    *  and where the code decides what actions to perform.  
    */
   void task(void) {
+    Config.subscribe(NULL, LTE_CONFIG_GROUPS);
     if (!lteDetect()) {
       log_w("LARA-R6/SARA-R5/LENA-R8 not detected, check wiring");
     } else {
@@ -920,20 +1449,34 @@ protected:
         // detect if LTE was turned off
         if (LTE_ON_ACTIVE != digitalRead(LTE_ON)) {
           UbxSerial.end();
+          ntripDirect = ntripDirectClosed = false;
+          lost();
           setState(INIT, LTE_DETECT_RETRY);
         }
       }
         
       if (state != INIT) {
-        SARA_R5::poll();
+        if (ntripDirect) {
+          // in direct link mode the UART carries the raw stream and no URCs
+          ntripDirectRead();
+        } else {
+          SARA_R5::poll();
+        }
       }
       
       int32_t now = millis();
+      // only re-read the configuration if it was changed, and react immediately
+      uint32_t generation = Config.getGeneration(LTE_CONFIG_GROUPS);
+      if (configGeneration != generation) {
+        configGeneration = generation;
+        id     = Config.getValue(CONFIG::KEY_CLIENTID);
+        ntrip  = Config.getValue(CONFIG::KEY_NTRIP_SERVER);
+        useSrc = Config.getValue(CONFIG::KEY_USESOURCE);
+        ttagNextTry = now;
+      }
       if (0 >= (ttagNextTry - now)) {
         ttagNextTry = now + LTE_1S_RETRY;
-        String id = Config.getValue(CONFIG_VALUE_CLIENTID);
-        String ntrip = Config.getValue(CONFIG_VALUE_NTRIP_SERVER);
-        String useSrc = Config.getValue(CONFIG_VALUE_USESOURCE);
+        bool reconnect = (connectGeneration != configGeneration);
         bool onlineWlan = WiFi.status() == WL_CONNECTED;
         bool useWlan   = (-1 != useSrc.indexOf("WLAN")) && onlineWlan;
         bool useLte    = (-1 != useSrc.indexOf("LTE"))  && !useWlan;
@@ -958,16 +1501,29 @@ protected:
             }
             break;
           case REGISTERED:
-            ttagNextTry = now + LTE_ACTIVATION_RETRY;
-            if (lteActivate()) {
+            if ((0 == retries ++) && lteAttached()) {
+              // fast path, the context survived, no need to activate it again
+              log_i("context still active");
               setState(ONLINE);
+            } else {
+              // the +UUPSDA of the activation can take a while, don't start over before it had a chance
+              int32_t delay = backoff();
+              ttagNextTry = now + ((delay < LTE_ACTIVATE_RETRY) ? LTE_ACTIVATE_RETRY : delay);
+              if (lteActivate()) {
+                setState(ONLINE);
+              }
             }
             break;
           case ONLINE:
-            Config.lteReconnect = false;
-            if (useNtrip) {
+            if ((useNtrip || useMqtt) && (LTE_ATTACH_CHECK <= retries) && !lteAttached()) {
+              // connecting keeps failing and we lost the registration or context  
+              log_w("not attached anymore");
+              setState(WAITREGISTER);
+            } else if (useNtrip) {
               if (0 < ntrip.length()) {
-                ttagNextTry = now + LTE_CONNECT_RETRY;
+                retries ++;
+                ttagNextTry = now + backoff();
+                connectGeneration = configGeneration;
                 if (ntripConnect(ntrip)) {
                   setState(NTRIP);
                 }
@@ -977,13 +1533,20 @@ protected:
                 ttagNextTry = now + LTE_PROVISION_RETRY;
                 mqttProvision(); // callback will advance the state
               } else {
-                ttagNextTry = now + LTE_CONNECT_RETRY;
-                mqttConnect(id); // callback will advance the state
+                retries ++;
+                mqttBackoff = backoff();
+                connectGeneration = configGeneration;
+                if (mqttConnect(id)) {
+                  // callback will advance the state, if the URC does not come wait for the backoff after the timeout
+                  ttagNextTry = now + LTE_LOGIN_TIMEOUT + mqttBackoff;
+                } else {
+                  ttagNextTry = now + mqttBackoff;
+                }
               }
             }
             break;
           case MQTT:
-            if (!useMqtt || (0 == id.length()) || Config.lteReconnect) {
+            if (!useMqtt || (0 == id.length()) || reconnect) {
               if (mqttStop()) {
                 setState(ONLINE, LTE_1S_RETRY);
               }
@@ -992,7 +1555,7 @@ protected:
             }
             break;
           case NTRIP: 
-            if (!useNtrip || (0 == ntrip.length()) || Config.lteReconnect) {
+            if (!useNtrip || (0 == ntrip.length()) || reconnect) {
               ntripStop();
               setState(ONLINE, LTE_1S_RETRY);
             } else {
@@ -1004,10 +1567,17 @@ protected:
             break;
         }
       }
-      vTaskDelay(30);
+      // sleep, but wake up early if the configuration changes
+      ulTaskNotifyTake(pdTRUE, 30);
     }
   }
 
+  String id;                    //!< the PointPerfect client id, cached from the configuration
+  String ntrip;                 //!< the NTRIP server, cached from the configuration
+  String useSrc;                //!< the correction source, cached from the configuration
+  uint32_t configGeneration;    //!< the generation of the cached configuration
+  uint32_t connectGeneration;   //!< the generation of the configuration when the connection was established
+
   // -----------------------------------------------------------------------
   // HARDWARE 
   // -----------------------------------------------------------------------
@@ -1123,6 +1693,16 @@ protected:
         LTE_RXO, PIN_TXT(LTE_RXO), LTE_TXI, PIN_TXT(LTE_TXI),
         LTE_CTS, PIN_TXT(LTE_CTS), LTE_RTS, PIN_TXT(LTE_RTS));
       ready = begin(UbxSerial, LTE_BAUDRATE);
+      long baud = baudStored(NULL);
+      if (!ready && (0 < baud) && (LTE_BAUDRATE != baud)) {
+        // the modem may still run at the negotiated baudrate, move it back to the default 
+        log_i("try negotiated baudrate %ld", baud);
+        ready = begin(UbxSerial, baud) && (SARA_R5_SUCCESS == setBaud(LTE_BAUDRATE));
+        if (ready) {
+          beginSerial(LTE_BAUDRATE);
+          ready = (SARA_R5_SUCCESS == at());
+        }
+      }
     }
     return ready;
   }
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __TIMELINE_H__
+#define __TIMELINE_H__
+
+/** This class records the boot timeline. The subsystems are brought up concurrently in
+ *  their own tasks and each of them marks when it reaches its phase. The time from reset
+ *  to the first corrected fix is reported on every boot together with the full timeline.
+ */
+class TIMELINE {
+
+public:
+
+  //! the phases of the boot timeline
+  typedef enum {
+    FFS = 0,      //!< the file system is mounted
+    CONFIG,       //!< the configuration is parsed
+    GNSS,         //!< the GNSS receiver is detected and configured
+    LBAND,        //!< the LBAND receiver is detected and configured
+    WLAN,         //!< the WLAN is connected and online
+    LTE,          //!< the LTE modem is registered
+    SERVICE,      //!< the MQTT or NTRIP service is connected (WLAN or LTE)
+    CORRECTION,   //!< the first correction data is pushed to the GNSS receiver
+    FLOAT,        //!< the first RTK float solution
+    FIX,          //!< the first RTK fixed solution
+    NUM
+  } PHASE;
+  //! string conversion helper table, must be aligned and match with PHASE
+  const char* PHASE_LUT[PHASE::NUM] = {
+    "ffs", "config", "gnss", "lband", "wlan", "lte", "service", "correction", "float", "fix"
+  };
+
+  /** constructor
+   */
+  TIMELINE(void) {
+    mutex = xSemaphoreCreateMutex();
+    marked = 0;
+    for (int i = 0; i < PHASE::NUM; i ++) {
+      ttag[i] = 0;
+    }
+  }
+
+  /** mark that a phase was reached, only the first time is recorded, this can be called from any task
+   *  \param phase  the phase reached
+   */
+  void mark(PHASE phase) {
+    if ((0 == (marked & (1 << phase))) && (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY))) {
+      bool first = (0 == (marked & (1 << phase)));
+      if (first) {
+        marked |= (1 << phase);
+        ttag[phase] = millis();
+      }
+      xSemaphoreGive(mutex);
+      if (first) {
+        log_i("%s after %d ms", PHASE_LUT[phase], ttag[phase]);
+        if (phase == FIX) {
+          log_i("reset to first corrected fix %d ms", ttag[phase]);
+          dump();
+        }
+      }
+    }
+  }
+
+  /** dump the timeline of the phases reached so far
+   */
+  void dump(void) {
+    char buf[160];
+    int len = 0;
+    for (int i = 0; i < PHASE::NUM; i ++) {
+      if (marked & (1 << i)) {
+        len += snprintf(&buf[len], sizeof(buf) - len, " %s %d", PHASE_LUT[i], ttag[i]);
+      } else {
+        len += snprintf(&buf[len], sizeof(buf) - len, " %s -", PHASE_LUT[i]);
+      }
+    }
+    log_i("timeline ms:%s", buf);
+  }
+
+protected:
+
+  SemaphoreHandle_t mutex;        //!< protects the timeline
+  volatile uint32_t marked;       //!< bitmask of the phases reached
+  int32_t ttag[PHASE::NUM];       //!< time (millis() since reset) when the phase was reached
+};
+
+TIMELINE Timeline; //!< The global Timeline object
+
+#endif // __TIMELINE_H__
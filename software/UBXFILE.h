@@ -26,6 +26,12 @@ const int UBXSERIAL_BUFFER_SIZE   =      2*1024;  //!< Size of circular buffer,
 const int UBXWIRE_BUFFER_SIZE     =     12*1024;  //!< Size of circular buffer, typically we see about 2.5kBs coming from the GNSS
 const int UBXFILE_BLOCK_SIZE      =        1024;  //!< Size of the blocks used to pull from the GNSS and send to the File. 
 
+//#define UBXSERIAL_TIMESTAMP                     //!< Prefix each line of the AT command logfile with the time "[millis()] ", this also stamps binary data (MQTT messages, direct link) in the log
+const int UBXSERIAL_ATSTATS_NUM   =          32;  //!< Max number of different AT commands and URCs in the latency statistics
+const int UBXSERIAL_ATSTATS_BINS  =          16;  //!< Number of latency histogram bins, bin n holds latencies below 2^n ms, used for the p95 
+const int UBXSERIAL_ATSTATS_LINE  =          24;  //!< Characters of a line kept to identify the AT command or URC 
+const int UBXSERIAL_ATSTATS_INTERVAL =    60000;  //!< Dump interval of the AT latency statistics in ms, set to 0 to disable
+
 #define   UBXSD_DIR                       "/LOG"  //!< Directory on the SD card to store logfiles in 
 #define   UBXSD_UBXFORMAT        "/HPG-%04d.UBX"  //!< The UBX logfiles name format
 #define   UBXSD_ATFORMAT         "/HPG-%04d.TXT"  //!< The AT command logfiles name format
@@ -189,9 +195,7 @@ public:
    */ 
   size_t write(uint8_t ch) override {
     if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      if (buffer.size() > 1) { 
-        buffer.write((const char*)&ch, 1);
-      }
+      record((const char*)&ch, 1, true);
       xSemaphoreGive(mutex);
     }
     return HardwareSerial::write(ch);
@@ -204,9 +208,7 @@ public:
    */ 
   size_t write(const uint8_t *ptr, size_t size) override {
     if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-      if (buffer.size() > 1) { 
-        buffer.write((const char*)ptr, size);
-      } 
+      record((const char*)ptr, size, true);
       xSemaphoreGive(mutex);
     }
     return HardwareSerial::write(ptr, size);  
@@ -219,15 +221,229 @@ public:
     int ch = HardwareSerial::read();
     if (-1 != ch) {
       if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-        if (buffer.size() > 1) { 
-          buffer.write((const char*)&ch, 1);
-        } 
+        char c = ch;
+        record(&c, 1, false);
         xSemaphoreGive(mutex);
       }
     }
     return ch;
   }
-  
+
+  // --------------------------------------------------------------------------------------
+  // AT command latency statistics
+  // --------------------------------------------------------------------------------------
+
+  /** get the AT command latency statistics as text, one line per command or URC 
+   *  \return  the statistics
+   */
+  String atStats(void) {
+    String text;
+    if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+      for (int i = 0; i < atStatsNum; i ++) {
+        const ATSTAT& stat = atStatsTable[i];
+        char line[96];
+        if (0 < stat.timed) {
+          // the p95 is the upper bound of the histogram bin that reaches 95% of the samples
+          uint32_t limit = (stat.timed * 95 + 99) / 100;
+          uint32_t sum = 0;
+          int bin = 0;
+          while ((bin < UBXSERIAL_ATSTATS_BINS - 1) && ((sum += stat.hist[bin]) < limit)) {
+            bin ++;
+          }
+          uint32_t p95 = (bin < UBXSERIAL_ATSTATS_BINS - 1) ? (1UL << bin) : stat.max;
+          snprintf(line, sizeof(line), "%s n %u mean %u p95 <%u max %u ms\r\n", stat.name, stat.count, 
+                   stat.sum / stat.timed, (p95 < stat.max) ? p95 : stat.max, stat.max);
+        } else {
+          snprintf(line, sizeof(line), "%s n %u\r\n", stat.name, stat.count);
+        }
+        text += line;
+      }
+      xSemaphoreGive(mutex);
+    }
+    return text;
+  }
+
+  /** dump the AT command latency statistics periodically to the log, needs to be called from a task
+   */
+  void atStatsPoll(void) {
+    int32_t now = millis();
+    if (UBXSERIAL_ATSTATS_INTERVAL && (0 >= (ttagAtStats - now))) {
+      ttagAtStats = now + UBXSERIAL_ATSTATS_INTERVAL;
+      String text = atStats();
+      int pos = 0;
+      while (pos < text.length()) {
+        int end = text.indexOf("\r\n", pos);
+        log_i("AT %s", text.substring(pos, end).c_str());
+        pos = end + 2;
+      }
+    }
+  }
+
+protected:
+
+  /** pass the data to the circular buffer and the AT command parser, must be called with the mutex taken 
+   *  \param ptr   pointer to the data
+   *  \param size  number of bytes in ptr
+   *  \param tx    true if data is sent to the modem, false if received 
+   */
+  void record(const char* ptr, size_t size, bool tx) {
+    int32_t now = millis();
+    bool log = (buffer.size() > 1);
+    size_t start = 0;
+    for (size_t i = 0; i < size; i ++) {
+      char ch = ptr[i];
+      bool eol = (ch == '\r') || (ch == '\n');
+#ifdef UBXSERIAL_TIMESTAMP
+      if (log && lineStart && !eol) {
+        // flush what we have so far and then insert the time stamp
+        buffer.write(&ptr[start], i - start);
+        start = i;
+        char stamp[16];
+        int len = snprintf(stamp, sizeof(stamp), "[%d] ", now);
+        buffer.write(stamp, len);
+      }
+      lineStart = eol;
+#endif
+      atParse(ch, eol, tx, now);
+    }
+    if (log) {
+      buffer.write(&ptr[start], size - start);
+    }
+  }
+
+  //! statistics of a single AT command or URC 
+  typedef struct {
+    char name[16];                          //!< the command e.g. AT+UMQTTC or URC e.g. +UUMQTTC
+    uint32_t count;                         //!< number of commands or URCs seen
+    uint32_t timed;                         //!< number of samples with a latency
+    uint32_t sum;                           //!< sum of latencies in ms
+    uint32_t max;                           //!< max latency in ms
+    int32_t ttagLast;                       //!< time (millis()) of the last command, used to time the URCs that complete it
+    uint16_t hist[UBXSERIAL_ATSTATS_BINS];  //!< histogram of the latencies
+  } ATSTAT;
+
+  //! a line received or sent, truncated to what is needed to identify it
+  typedef struct {
+    char buf[UBXSERIAL_ATSTATS_LINE];       //!< the line
+    int len;                                //!< the characters in buf
+  } ATLINE;
+
+  /** find or add the statistics of a command or URC, must be called with the mutex taken 
+   *  \param name  the command or URC
+   *  \param add   true if a missing entry should be added
+   *  \return      the statistics or NULL if not found or the table is full 
+   */
+  ATSTAT* atFind(const char* name, bool add) {
+    for (int i = 0; i < atStatsNum; i ++) {
+      if (0 == strcmp(atStatsTable[i].name, name)) {
+        return &atStatsTable[i];
+      }
+    }
+    if (!add || (atStatsNum >= UBXSERIAL_ATSTATS_NUM)) {
+      return NULL;
+    }
+    ATSTAT* stat = &atStatsTable[atStatsNum ++];
+    memset(stat, 0, sizeof(*stat));
+    strncpy(stat->name, name, sizeof(stat->name) - 1);
+    return stat;
+  }
+
+  /** add a sample to the statistics, must be called with the mutex taken 
+   *  \param name  the command or URC
+   *  \param ms    the latency or a negative value if the sample is only counted 
+   */
+  void atRecord(const char* name, int32_t ms) {
+    ATSTAT* stat = atFind(name, true);
+    if (NULL != stat) {
+      stat->count ++;
+      if (0 <= ms) {
+        int bin = 0;
+        while ((bin < UBXSERIAL_ATSTATS_BINS - 1) && (ms >= (1L << bin))) {
+          bin ++;
+        }
+        stat->hist[bin] ++;
+        stat->timed ++;
+        stat->sum += ms;
+        stat->max = (ms > stat->max) ? ms : stat->max;
+      }
+    }
+  }
+
+  /** Track the AT commands written and the final result codes and URCs read, this measures the 
+   *  time from sending a command to its final result code. URCs that complete a command, like 
+   *  +UUMQTTC for AT+UMQTTC, are timed from the last such command, any other URC is counted.   
+   *  \param ch   the character 
+   *  \param eol  the character terminates a line
+   *  \param tx   true if sent to the modem, false if received 
+   *  \param now  the current time
+   */
+  void atParse(char ch, bool eol, bool tx, int32_t now) {
+    ATLINE& line = tx ? atTx : atRx;
+    if (!eol) {
+      if (line.len < sizeof(line.buf) - 1) {
+        line.buf[line.len ++] = ch;
+      }
+      return;
+    } else if (0 == line.len) {
+      return;
+    } 
+    line.buf[line.len] = '\0';
+    line.len = 0;
+    const char* str = line.buf;
+    char name[sizeof(atCmd)];
+    if (tx) {
+      if (0 == strncmp(str, "AT", 2)) {
+        // the name of the command ends where its parameters start
+        size_t len = strcspn(str, "=?");
+        len = (len < sizeof(atCmd) - 1) ? len : sizeof(atCmd) - 1;
+        memcpy(atCmd, str, len);
+        atCmd[len] = '\0';
+        atTtag = now;
+        atPending = true;
+        ATSTAT* stat = atFind(atCmd, true);
+        if (NULL != stat) {
+          stat->ttagLast = now;
+        }
+      }
+    } else if (atPending && ((0 == strcmp(str, "OK")) || (0 == strncmp(str, "ERROR", 5)) || 
+                             (0 == strncmp(str, "+CME ERROR", 10)) || (0 == strncmp(str, "+CMS ERROR", 10)))) {
+      atPending = false;
+      atRecord(atCmd, now - atTtag);
+    } else if ((0 == strncmp(str, "+UU", 3)) || (('+' == *str) && !atPending)) {
+      size_t len = strcspn(str, ":");
+      // only count real URC names, not binary data that happens to start with a '+'
+      if ((len < 2) || (len >= sizeof(name)) || (len != strspn(str, "+ABCDEFGHIJKLMNOPQRSTUVWXYZ"))) {
+        return;
+      }
+      memcpy(name, str, len);
+      name[len] = '\0';
+      // URCs reporting the result of a command, +UUxxx completes AT+Uxxx
+      const char* COMPLETE[] = { "+UUMQTTC", "+UUHTTPCR", "+UUPSDA", "+UUSOCO" };
+      int32_t ms = -1;
+      for (int i = 0; i < sizeof(COMPLETE)/sizeof(*COMPLETE); i ++) {
+        if (0 == strcmp(name, COMPLETE[i])) {
+          char cmd[sizeof(atCmd)];
+          snprintf(cmd, sizeof(cmd), "AT+%s", &name[2]);
+          ATSTAT* stat = atFind(cmd, false);
+          ms = (NULL != stat) ? (now - stat->ttagLast) : -1;
+        }
+      }
+      atRecord(name, ms);
+    }
+  }
+
+  ATSTAT atStatsTable[UBXSERIAL_ATSTATS_NUM]; //!< the statistics of the AT commands and URCs
+  int atStatsNum = 0;           //!< number of entries used in atStatsTable
+  ATLINE atTx = { "", 0 };      //!< the line being sent
+  ATLINE atRx = { "", 0 };      //!< the line being received
+  char atCmd[16] = "";          //!< the command waiting for its final result code
+  int32_t atTtag = 0;           //!< time (millis()) when atCmd was sent
+  bool atPending = false;       //!< a command is waiting for its final result code
+  bool lineStart = true;        //!< the next character starts a new line in the log 
+  int32_t ttagAtStats = 0;      //!< time (millis()) of the next dump of the statistics
+
+public:
+
 #ifdef UBXSERIAL_OVERRIDE_FLOWCONTROL
   // The arduino_esp32 core has a bug that some pins are swapped in the setPins function. 
   // PR https://github.com/espressif/arduino-esp32/pull/6816#pullrequestreview-987757446 was issued
@@ -17,31 +17,157 @@
 #ifndef __WEBSOCKET__H__
 #define __WEBSOCKET__H__
 
+#include <list>
+#include <deque>
 #include <ArduinoWebsockets.h>
+#include "WEBSOCKET_WWW.h"  // the gzip compressed files of the www folder, run www/generate.py to update
 using namespace websockets;
 
-const uint16_t WEBSOCKET_PORT     =        8080; //!< needs to match WEBSOCKET_HTML and hpg.mazg.ch value
+const uint16_t WEBSOCKET_PORT     =        8080; //!< needs to match www/monitor.js and hpg.mazg.ch value
+const size_t WEBSOCKET_CLIENT_QUEUE  =    8*1024; //!< max bytes queued per client, raw data beyond this is dropped 
+const size_t WEBSOCKET_CLIENT_BUDGET =    2*1024; //!< max bytes sent to a single client per poll
+const int WEBSOCKET_CLIENT_SLOW      =        50; //!< a send that takes longer (ms) ends the clients turn of this poll 
+const int WEBSOCKET_CLIENT_EVICT     =     10000; //!< time (ms) after which a client that stays behind is disconnected
+const int WEBSOCKET_DROP_REPORT      =      1000; //!< minimum interval (ms) between drop reports to a client
+const int WEBSOCKET_POLL_INTERVAL    =        20; //!< max time (ms) between polls of the server and clients, data wakes the task earlier
+
+const char* WEBSOCKET_TASK_NAME      = "Websocket"; //!< Websocket task name
+const int WEBSOCKET_STACK_SIZE       =    4*1024; //!< Websocket task stack size
+const int WEBSOCKET_TASK_PRIO        =         2; //!< Websocket task priority, above the Wlan task to keep the latency low
+const int WEBSOCKET_TASK_CORE        =         1; //!< Websocket task MCU code
 
 #define WEBSOCKET_HPGMAZGCHURL    "http://hpg.mazg.ch"
 #define WEBSOCKET_HPGMAZGCHNAME   "mazg.ch HPG Monitor"
-#define WEBSOCKET_URL             "/monitor.html"
+#define WEBSOCKET_URL             "/monitor.html"  //!< the urls of the files in the www folder
 #define WEBSOCKET_JSURL           "/monitor.js"
 #define WEBSOCKET_CSSURL          "/monitor.css"
 #define WEBSOCKET_BUTTON          "Monitor"
 
-/** This class encapsulates all WLAN functions. 
+//#define WEBSOCKET_TELEMETRY_TEXT                   //!< uncomment to send the position as a text line instead of the binary telemetry
+#define WEBSOCKET_TELEMETRY_MAGIC   "HPGT"           //!< identifies the binary telemetry message, needs to match www/monitor.js
+const uint8_t WEBSOCKET_TELEMETRY_VERSION =     1; //!< version of the WEBSOCKET::TELEMETRY layout, needs to match www/monitor.js 
+
+/** A stream that collects the raw output of a receiver in a circular buffer, the data is 
+ *  only collected while at least one websocket client is subscribed to its channel. 
 */
-class WEBSOCKET : public Stream {
+class WEBSOCKETPORT : public Stream {
 
 public: 
 
   /** constructor
-   *  \param size  the size of the cicular buffer
+   *  \param channels  the channels subscribed by any client, maintained by the websocket 
+   *  \param task      the websocket task, it is notified when new data is available
+   *  \param channel   the channel mask of this port
+   *  \param size      the size of the cicular buffer
    */
-  WEBSOCKET(size_t size = 5*1024) : buffer{size} {
+  WEBSOCKETPORT(volatile uint32_t& channels, TaskHandle_t& task, uint32_t channel, size_t size) : 
+        channels{channels}, task{task}, channel{channel}, buffer{size} {
     mutex = xSemaphoreCreateMutex();
-    queue = xQueueCreate(5, sizeof(MSG));
-    connected = false;
+  }
+
+  /** fetch data from the circular buffer 
+   *  \param ptr   pointer to buffer to fill
+   *  \param size  size of the buffer
+   *  \return      the bytes fetched
+   */
+  size_t fetch(char* ptr, size_t size) {
+    size_t len = 0;
+    if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+      len = buffer.read(ptr, size);
+      xSemaphoreGive(mutex);
+    }
+    return len;
+  }
+
+  // --------------------------------------------------------------------------------------
+  // STREAM interface: https://github.com/arduino/ArduinoCore-API/blob/master/api/Stream.h
+  // --------------------------------------------------------------------------------------
+ 
+  /** The character written is passed into a circular buffer
+   *  \param ch  character to write
+   *  \return    the bytes written
+   */ 
+  size_t write(uint8_t ch) override {
+    size_t size = 0;
+    if (0 != (channels & channel)) {
+      if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+        bool wasEmpty = buffer.empty();
+        size = buffer.write(ch);
+        xSemaphoreGive(mutex);
+        notify(wasEmpty);
+      }
+    }
+    return size;
+  }
+  
+  /** All data written is passed into the circular buffer
+   *  \param ptr   pointer to buffer to write
+   *  \param size  number of bytes in ptr to write
+   *  \return      the bytes written
+   */ 
+  size_t write(const uint8_t *ptr, size_t size) override {
+    if (0 != (channels & channel)) {
+      if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
+        bool wasEmpty = buffer.empty();
+        size = buffer.write((const char*)ptr, size);
+        xSemaphoreGive(mutex);
+        notify(wasEmpty);
+      }
+    }
+    return size;
+  }
+  
+  /** override flush functions of the stream interface 
+   */
+  void flush(void)    override { /*nothing*/ }
+  
+  /** override available functions of the stream interface 
+   *  \return  nothing available
+   */
+  int available(void) override { return   0; }
+  
+  /** override read functions of the stream interface 
+   *  \return  a bad character
+   */
+  int read(void)      override { return  -1; }
+  
+  /** override peek functions of the stream interface 
+   *  \return  a bad character
+   */
+  int peek(void)      override { return  -1; }
+
+protected:
+  /** wake the websocket task, the receiver libraries write byte by byte, so this is only done 
+   *  when the first data is added to an empty buffer, the task will then fetch all of it
+   *  \param wasEmpty  the buffer was empty before the write
+   */
+  void notify(bool wasEmpty) {
+    if (wasEmpty && (NULL != task)) {
+      xTaskNotifyGive(task);
+    }
+  }
+  
+  volatile uint32_t& channels;  //!< the channels subscribed by any client 
+  TaskHandle_t& task;           //!< the websocket task
+  const uint32_t channel;       //!< the channel mask of this port
+  SemaphoreHandle_t mutex;      //!< protects cbuf from concurnet access by tasks. 
+  cbuf buffer;                  //!< the circular local buffer
+};
+
+/** This class encapsulates all WLAN functions. 
+*/
+class WEBSOCKET {
+
+public: 
+
+  /** constructor
+   *  \param size  the size of the cicular buffer of the GNSS port
+   */
+  WEBSOCKET(size_t size = 5*1024) : 
+      gnssPort{channels, wsTask, 1 << CHANNEL_GNSS, size}, lbandPort{channels, wsTask, 1 << CHANNEL_LBAND, 2*1024} {
+    queue = xQueueCreate(5, sizeof(MSG*));
+    channels = 0;
+    wsTask = NULL;
   }
 
   /** attach the the websocket to the manager and start listening
@@ -55,63 +181,119 @@ public:
     if (!wsServer.available()) {
       log_i("server unavailable");
     }
+    if (NULL == wsTask) {
+      xTaskCreatePinnedToCore(task, WEBSOCKET_TASK_NAME, WEBSOCKET_STACK_SIZE, this, WEBSOCKET_TASK_PRIO, &wsTask, WEBSOCKET_TASK_CORE);
+    }
   }
 
   /** register the pages to be served
    */
   void bind(void) {
     if ((NULL != pManager) && (NULL != pManager->server)) {
+      // we need the If-None-Match header to answer with a 304 if the browser has the file cached
+      static const char* headers[] = { "If-None-Match" };
+      pManager->server->collectHeaders(headers, sizeof(headers)/sizeof(*headers));
       pManager->server->on(WEBSOCKET_URL,    std::bind(&WEBSOCKET::serveHtml, this));
       pManager->server->on(WEBSOCKET_JSURL,  std::bind(&WEBSOCKET::serveJs,   this));           
       pManager->server->on(WEBSOCKET_CSSURL, std::bind(&WEBSOCKET::serveCss,  this));           
     }
   }
 
-  /** check the available and potential new clients
+  /** check the available and potential new clients, this is called from the websocket task only
    */
   void poll(void) {
     // poll all clients
-    for (auto it = wsClients.begin(); (it != wsClients.end()); it = std::next(it)) {
-      if (it->available()) {
-        it->poll();
+    for (auto it = wsClients.begin(); (it != wsClients.end()); ) {
+      if (it->client.available()) {
+        it->client.poll();
+        it = std::next(it);
       } else {
         log_i("client unavailable");
-        it->close();
-        wsClients.erase(it);
-        it = std::prev(it);
+        it = clientClose(it);
       }
     }
     if (wsServer.poll()) {
       // check for a new client
-      WebsocketsClient client = wsServer.accept();
-      client.onMessage(onMessage);
-      client.onEvent(onEvent);
-      client.ping();
+      log_i("new client, total %d", wsClients.size() + 1);
+      wsClients.push_back(CLIENT());
+      CLIENT& newClient = wsClients.back(); 
+      newClient.client = wsServer.accept();
+      newClient.client.onMessage([this, &newClient](WebsocketsClient &client, WebsocketsMessage message) {
+        onMessage(newClient, message);
+      });
+      newClient.client.onEvent(onEvent);
+      newClient.client.ping();
+      // by default a client gets all channels, except the binary telemetry that older monitors would take for UBX data
+      newClient.channels = ((1 << CHANNEL_NUM) - 1) & ~(1 << CHANNEL_TELEMETRY);
+      for (int ch = 0; ch < CHANNEL_NUM; ch ++) {
+        newClient.decimation[ch] = 1;
+        newClient.counter[ch] = 0;
+      }
+      newClient.queued = 0;
+      newClient.droppedMsgs = 0;
+      newClient.droppedBytes = 0;
+      newClient.reportedMsgs = 0;
+      newClient.ttagReport = millis();
+      newClient.behind = false;
+      newClient.ttagBehind = 0;
       String string = Config.getDeviceName();
       string = "Connected to " + string + "\r\n";
-      client.send(string.c_str());
-      log_i("new client, total %d", wsClients.size() + 1);
-      wsClients.push_back(client);
+      clientStatus(newClient, string);
     }
-    connected = wsClients.size() > 0;
+    updateChannels();
     send();
   }
 
-  // --------------------------------------------------------------------------------------
-  // STREAM interface: https://github.com/arduino/ArduinoCore-API/blob/master/api/Stream.h
-  // --------------------------------------------------------------------------------------
- 
   typedef enum                          {  WLAN = 0, LTE,   LBAND,   GNSS, NUM } SOURCE; //!< source enum for MSG
   const char* SOURCE_LUT[SOURCE::NUM] = { "WLAN",   "LTE", "LBAND", "GNSS"     };  //!< source to text conversion
+  typedef enum                                   {  CHANNEL_STATUS = 0, CHANNEL_TELEMETRY, CHANNEL_CORRECTIONS, CHANNEL_GNSS, CHANNEL_LBAND, CHANNEL_NUM } CHANNEL; //!< the channels a client can subscribe to
+  const char* CHANNEL_LUT[CHANNEL::CHANNEL_NUM] = { "status",            "telemetry",       "corrections",       "gnss",       "lband"                 };  //!< channel to text conversion, needs to match www/monitor.js
   typedef struct { 
+    uint32_t refs;            //!< number of references, the last one releases the message 
     SOURCE source;            //!< source of data 
-    char* data;               //!< data buffer, allocated by calling task and released  by consumers  
+    CHANNEL channel;          //!< the channel of the data 
+    char* data;               //!< data buffer, allocated together with this header  
     size_t size;              //!< data size
     bool binary;              //!< type of the data 
-  } MSG;                      //!< queue element
+  } MSG;                      //!< refcounted message, shared by the queue of all clients
   xQueueHandle queue;         //!< queue to hold the different data to be sent to the websocket
-  SemaphoreHandle_t mutex;    //!< protects cbuf from concurnet access by tasks. 
-  cbuf buffer;                //!< the circular local buffer
+  
+  enum { 
+    TELEMETRY_FIXOK = 1,      //!< gnssFixOK flag of UBX-NAV-PVT
+    TELEMETRY_DIFF  = 2,      //!< diffSoln flag of UBX-NAV-PVT
+    TELEMETRY_HP    = 4,      //!< the high precision fields are valid 
+  };                          //!< bits of TELEMETRY.flags
+  typedef struct __attribute__((packed)) {
+    char magic[4];            //!< WEBSOCKET_TELEMETRY_MAGIC
+    uint8_t version;          //!< WEBSOCKET_TELEMETRY_VERSION
+    uint8_t source;           //!< the correction source in use, GNSS::SOURCE 
+    uint8_t fixType;          //!< fix type of UBX-NAV-PVT
+    uint8_t carrSoln;         //!< carrier solution, 0 = no, 1 = float, 2 = fixed
+    uint8_t flags;            //!< combination of TELEMETRY_FIXOK, TELEMETRY_DIFF and TELEMETRY_HP
+    uint8_t numSV;            //!< number of satellites used
+    uint8_t corrAge;          //!< age of the last correction, the lastCorrectionAge range code of UBX-NAV-PVT (not seconds)
+    uint8_t month;            //!< UTC month
+    uint16_t year;            //!< UTC year
+    uint8_t day;              //!< UTC day
+    uint8_t hour;             //!< UTC hour
+    uint8_t min;              //!< UTC minute
+    uint8_t sec;              //!< UTC second
+    uint32_t iTOW;            //!< GPS time of week (ms)
+    int32_t lat;              //!< latitude (1e-7 deg)
+    int32_t lon;              //!< longitude (1e-7 deg)
+    int32_t height;           //!< height above ellipsoid (mm)
+    int32_t hMSL;             //!< height above mean sea level (mm)
+    int8_t latHp;             //!< high precision latitude part (1e-9 deg)
+    int8_t lonHp;             //!< high precision longitude part (1e-9 deg)
+    int8_t heightHp;          //!< high precision height part (0.1 mm)
+    int8_t hMSLHp;            //!< high precision height above mean sea level part (0.1 mm)
+    uint32_t hAcc;            //!< horizontal accuracy (mm)
+    uint32_t vAcc;            //!< vertical accuracy (mm)
+  } TELEMETRY;                //!< binary position telemetry for the monitor, little endian
+  static_assert(sizeof(TELEMETRY) == 50, "TELEMETRY layout needs to match www/monitor.js");
+  volatile uint32_t channels; //!< the channels subscribed by any client, nothing is queued for the other channels 
+  WEBSOCKETPORT gnssPort;     //!< the raw output of the GNSS receiver
+  WEBSOCKETPORT lbandPort;    //!< the raw output of the LBAND receiver
   
   /** write data into the queue to be sent 
    *  \param buffer  data to write
@@ -122,23 +304,23 @@ public:
    */
   size_t write(const void* buffer, size_t size, SOURCE source, bool binary = true) {
     size_t wrote = 0;
-    if (connected) {
-      MSG msg;
-      msg.data = new char[size];
-      if (msg.data) {
-        memcpy(msg.data, buffer, size);
-        msg.size = size;
-        msg.source = source;
-        msg.binary = binary;
+    // position data from the GNSS goes to the telemetry, anything else is correction data 
+    CHANNEL channel = (source == SOURCE::GNSS) ? CHANNEL_TELEMETRY : CHANNEL_CORRECTIONS;
+    if (0 != (channels & (1 << channel))) {
+      MSG* msg = msgAlloc(buffer, size, source, channel, binary);
+      if (NULL != msg) {
         if (xQueueSendToBack(queue, &msg, 0/*portMAX_DELAY*/) == pdPASS) {
           log_d("queue %d bytes from %d(%s)", size, source, SOURCE_LUT[source]);
-          wrote += msg.size;
+          wrote += size;
+          if (NULL != wsTask) {
+            xTaskNotifyGive(wsTask);
+          }
         } else {
           log_e("queue %d bytes from %d(%s) failed, queue full", size, source, SOURCE_LUT[source]);
-          delete [] msg.data;
+          msgRelease(msg);
         }
       } else {
-        log_e("queue %d bytes from %d(%s), failed alloc", size, SOURCE_LUT[source]);
+        log_e("queue %d bytes from %d(%s), failed alloc", size, source, SOURCE_LUT[source]);
       }
     }
     return wrote;
@@ -153,123 +335,329 @@ public:
     return write(buffer, strlen(buffer), source, false);
   }
 
-  /** send both the message queue data as well as the cicular buffer to the websocket. 
-   *  This will also free any buffer allocated in the queue elements.
+  /** distribute both the message queue data as well as the cicular buffer to the queues of the 
+   *  clients and then send from each of the client queues. This will also free any buffer allocated 
+   *  in the queue elements.
    */
   void send(void) {
     int total = 0;
-    MSG msg;
+    int32_t start = micros();
+    MSG* msg;
     while (xQueueReceive(queue, &msg, 0/*portMAX_DELAY*/) == pdPASS) {
       for (auto it = wsClients.begin(); (it != wsClients.end()); it = std::next(it)) {
-        if (it->available()) {
-          if (msg.binary) {
-            it->sendBinary(msg.data, msg.size);
-          } else {
-            it->send(msg.data, msg.size);
-          }
-        }
+        clientQueue(*it, msg);
       }
-      total += msg.size;
-      log_d("queue %d bytes from %d(%s)", msg.size, msg.source, SOURCE_LUT[msg.source]);
-      delete [] msg.data;
-      msg.data = NULL;
+      total += msg->size;
+      log_d("queue %d bytes from %d(%s)", msg->size, msg->source, SOURCE_LUT[msg->source]);
+      msgRelease(msg); // release the reference of the queue
     }
-    bool loop;
-    do {
-      loop = false;
-      if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-        uint8_t temp[UBXFILE_BLOCK_SIZE];
-        size_t len = buffer.read((char*)temp, sizeof(temp));
-        xSemaphoreGive(mutex);
+    const struct { WEBSOCKETPORT* port; SOURCE source; CHANNEL channel; } ports[] = { 
+      { &gnssPort, SOURCE::GNSS, CHANNEL_GNSS }, { &lbandPort, SOURCE::LBAND, CHANNEL_LBAND } 
+    };
+    for (int i = 0; i < sizeof(ports)/sizeof(*ports); i ++) {
+      size_t len;
+      do {
+        char temp[UBXFILE_BLOCK_SIZE];
+        len = ports[i].port->fetch(temp, sizeof(temp));
         if (0 < len) {
-          for (auto it = wsClients.begin(); (it != wsClients.end()); it = std::next(it)) {
-            if (it->available()) {
-              it->sendBinary((const char*)temp, len);
+          msg = msgAlloc(temp, len, ports[i].source, ports[i].channel, true);
+          if (NULL != msg) {
+            for (auto it = wsClients.begin(); (it != wsClients.end()); it = std::next(it)) {
+              clientQueue(*it, msg);
             }
+            msgRelease(msg);
+          } else {
+            log_e("buffer %d bytes, failed alloc", len);
           }
-          log_d("buffer %d bytes", len);
+          log_d("buffer %d bytes from %d(%s)", len, ports[i].source, SOURCE_LUT[ports[i].source]);
           total += len;
-          loop = true;
         }
+      } while (0 < len);
+    }
+    if (0 < total) {
+      log_d("total %d bytes to %d clients, distributed in %d us", total, wsClients.size(), micros() - start);
+    }
+    for (auto it = wsClients.begin(); (it != wsClients.end()); ) {
+      if (clientSend(*it)) {
+        it = std::next(it);
+      } else {
+        it = clientClose(it);
       }
       vTaskDelay(0); // Yield
-    } while (loop);
-    if (0 < total) {
-      log_d("total %d bytes", total);
     }
   }
     
-  // --------------------------------------------------------------------------------------
-  // STREAM interface: https://github.com/arduino/ArduinoCore-API/blob/master/api/Stream.h
-  // --------------------------------------------------------------------------------------
- 
-  /** The character written is passed into a circular buffer
-   *  \param ch  character to write
-   *  \return    the bytes written
-   */ 
-  size_t write(uint8_t ch) override {
-    size_t size = 0;
-    if (connected) {
-      if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-        size = buffer.write(ch);
-        xSemaphoreGive(mutex);
-      }
+protected:
+
+  /* FreeRTOS static task function, will just call the objects task function  
+   * \param pvParameters the Websocket object (this)
+   */
+  static void task(void * pvParameters) {
+    ((WEBSOCKET*) pvParameters)->task();
+  }
+  
+  /** This task accepts, polls and sends to the websocket clients. It is woken as soon as data 
+   *  is queued, so that the delivery is not delayed by the blocking operations of the Wlan task.
+   */
+  void task(void) {
+    while(true) {
+      poll();
+      ulTaskNotifyTake(pdTRUE, WEBSOCKET_POLL_INTERVAL);
     }
-    return size;
   }
   
-  /** All data written is passed into the circular buffer
-   *  \param ptr   pointer to buffer to write
-   *  \param size  number of bytes in ptr to write
-   *  \return      the bytes written
-   */ 
-  size_t write(const uint8_t *ptr, size_t size) override {
-    if (connected) {
-      if (pdTRUE == xSemaphoreTake(mutex, portMAX_DELAY)) {
-        size = buffer.write((const char*)ptr, size);
-        xSemaphoreGive(mutex);
+  /** Allocate a message with a single reference, header and data share one allocation.
+   *  \param data    the data to copy into the message
+   *  \param size    the data size
+   *  \param source  the origin of this data
+   *  \param channel the channel of this data
+   *  \param binary  true for raw data, false for status lines 
+   *  \return        the message or NULL if out of memory
+   */
+  static MSG* msgAlloc(const void* data, size_t size, SOURCE source, CHANNEL channel, bool binary) {
+    MSG* msg = (MSG*)new uint8_t[sizeof(MSG) + size];
+    if (NULL != msg) {
+      msg->refs = 1;
+      msg->source = source;
+      msg->channel = channel;
+      msg->data = (char*)(msg + 1);
+      msg->size = size;
+      msg->binary = binary;
+      memcpy(msg->data, data, size);
+    }
+    return msg;
+  }
+
+  /** Add a reference to a message. References are only taken and released from the 
+   *  websocket task once the message left the queue, so no locking is needed.
+   *  \param msg  the message
+   *  \return     the message
+   */
+  static MSG* msgRef(MSG* msg) {
+    msg->refs ++;
+    return msg;
+  }
+
+  /** Release a reference to a message, the last one frees it. 
+   *  \param msg  the message
+   */
+  static void msgRelease(MSG* msg) {
+    if (0 == -- msg->refs) {
+      delete [] (uint8_t*)msg;
+    }
+  }
+
+  typedef struct {
+    WebsocketsClient client;        //!< the websocket client
+    std::deque<MSG*> pending;       //!< the bounded send queue of this client, holds a reference
+    size_t queued;                  //!< bytes in the pending queue
+    uint32_t channels;              //!< the channels subscribed by this client
+    uint16_t decimation[CHANNEL_NUM]; //!< only every n-th message of a channel is queued 
+    uint16_t counter[CHANNEL_NUM];  //!< message counter for the decimation 
+    uint32_t droppedMsgs;           //!< number of raw data messages dropped
+    uint32_t droppedBytes;          //!< number of raw data bytes dropped
+    uint32_t reportedMsgs;          //!< droppedMsgs when we last reported to the client
+    int32_t ttagReport;             //!< time of the last drop report
+    bool behind;                    //!< the client is not keeping up with the data
+    int32_t ttagBehind;             //!< time when the client started to fall behind 
+  } CLIENT;                         //!< a websocket client with its send queue
+
+  /** Add a message to the send queue of a client, if the queue is full the oldest raw 
+   *  data is dropped first, status lines are always queued. 
+   *  \param client  the client 
+   *  \param msg     the message, the queue takes its own reference
+   */
+  void clientQueue(CLIENT& client, MSG* msg) {
+    // skip channels not subscribed and apply the decimation
+    if (0 == (client.channels & (1 << msg->channel))) {
+      return;
+    }
+    if (0 != (client.counter[msg->channel] ++ % client.decimation[msg->channel])) {
+      return;
+    }
+    if (msg->binary) {
+      // drop the oldest raw data until the new data fits
+      for (auto it = client.pending.begin(); (it != client.pending.end()) && 
+                            (client.queued + msg->size > WEBSOCKET_CLIENT_QUEUE); ) {
+        if ((*it)->binary) {
+          client.queued -= (*it)->size;
+          client.droppedBytes += (*it)->size;
+          client.droppedMsgs ++;
+          msgRelease(*it);
+          it = client.pending.erase(it);
+        } else {
+          it = std::next(it);
+        }
+      }
+      if (client.queued + msg->size > WEBSOCKET_CLIENT_QUEUE) {
+        client.droppedBytes += msg->size;
+        client.droppedMsgs ++;
+        return;
       }
     }
-    return size;
+    client.pending.push_back(msgRef(msg));
+    client.queued += msg->size;
   }
-  
-  /** override flush functions of the stream interface 
+
+  /** Queue a status line to a client, status lines are always sent
+   *  \param client  the client 
+   *  \param string  the status line
    */
-  void flush(void)    override { /*nothing*/ }
-  
-  /** override available functions of the stream interface 
-   *  \return  nothing available
+  void clientStatus(CLIENT& client, const String& string) {
+    MSG* msg = msgAlloc(string.c_str(), string.length(), SOURCE::WLAN, CHANNEL_STATUS, false);
+    if (NULL != msg) {
+      clientQueue(client, msg);
+      msgRelease(msg);
+    }
+  }
+
+  /** Update the channels subscribed by any client, the producers use this to skip the 
+   *  data before any copy is made.
    */
-  int available(void) override { return   0; }
-  
-  /** override read functions of the stream interface 
-   *  \return  a bad character
+  void updateChannels(void) {
+    uint32_t mask = 0;
+    for (auto it = wsClients.begin(); (it != wsClients.end()); it = std::next(it)) {
+      mask |= it->channels;
+    }
+    if (mask != channels) {
+      log_d("channels 0x%02X", mask);
+      channels = mask;
+    }
+  }
+
+  /** Send the pending data of a client, this is limited to a budget per call so that a client 
+   *  on a slow link does not block the others. 
+   *  \param client  the client 
+   *  \return        false if the client should be disconnected
    */
-  int read(void)      override { return  -1; }
-  
-  /** override peek functions of the stream interface 
-   *  \return  a bad character
+  bool clientSend(CLIENT& client) {
+    int32_t now = millis();
+    // let the client know that it lost some data
+    if ((client.droppedMsgs != client.reportedMsgs) && (0 >= (client.ttagReport + WEBSOCKET_DROP_REPORT - now))) {
+      char string[80];
+      snprintf(string, sizeof(string), "Dropped %u messages, %u bytes of raw data\r\n", 
+            client.droppedMsgs, client.droppedBytes);
+      log_w("client behind, %s", string);
+      client.reportedMsgs = client.droppedMsgs;
+      client.ttagReport = now;
+      if (!client.client.send(string)) {
+        return false;
+      }
+    }
+    size_t budget = WEBSOCKET_CLIENT_BUDGET;
+    while (!client.pending.empty() && (0 < budget)) {
+      MSG* msg = client.pending.front(); 
+      client.pending.pop_front();
+      int32_t start = millis();
+      bool ok = msg->binary ? client.client.sendBinary(msg->data, msg->size) 
+                            : client.client.send(msg->data, msg->size);
+      int32_t duration = millis() - start;
+      budget -= (msg->size < budget) ? msg->size : budget;
+      client.queued -= msg->size;
+      msgRelease(msg);
+      if (!ok) {
+        log_w("client send failed");
+        return false;
+      }
+      if (duration > WEBSOCKET_CLIENT_SLOW) {
+        log_d("client slow, send took %d ms", duration);
+        break;
+      }
+    }
+    // evict clients that stay behind 
+    now = millis();
+    if (client.queued > WEBSOCKET_CLIENT_QUEUE / 2) {
+      if (!client.behind) {
+        client.behind = true;
+        client.ttagBehind = now;
+      } else if (0 >= (client.ttagBehind + WEBSOCKET_CLIENT_EVICT - now)) {
+        log_w("client behind for %d ms with %d bytes queued, disconnect", WEBSOCKET_CLIENT_EVICT, client.queued);
+        return false;
+      }
+    } else {
+      client.behind = false;
+    }
+    return true;
+  }
+
+  /** Close a client connection and free its send queue
+   *  \param it  the client to remove
+   *  \return    the iterator to the next client
    */
-  int peek(void)      override { return  -1; }
-   
-protected:
-  void serve(const char* file, const char* format, const char* content) {
-    log_i("send \"%s\" as \"%s\"", file, format);  
+  std::list<CLIENT>::iterator clientClose(std::list<CLIENT>::iterator it) {
+    for (auto pending = it->pending.begin(); pending != it->pending.end(); pending = std::next(pending)) {
+      msgRelease(*pending);
+    }
+    it->client.close();
+    it = wsClients.erase(it);
+    log_i("client closed, total %d", wsClients.size());
+    return it;
+  }
+
+  /** Serve a gzip compressed file directly from flash, if the browser has the file already 
+   *  cached (the ETag matches) only a 304 is returned.
+   *  \param file     the name of the file 
+   *  \param format   the mime type 
+   *  \param etag     the strong ETag of the file
+   *  \param content  the gzip compressed content
+   *  \param size     the size of the content
+   */
+  void serve(const char* file, const char* format, const char* etag, const uint8_t* content, size_t size) {
     if ((NULL != pManager) && (NULL != pManager->server)) {
-      pManager->server->send(200, format, content);
+      WebServer* server = pManager->server.get();
+      server->sendHeader("ETag", etag);
+      server->sendHeader("Cache-Control", "no-cache"); // revalidate using the ETag
+      if (server->header("If-None-Match").equals(etag)) {
+        log_i("send \"%s\" not modified", file);
+        server->send(304);
+      } else {
+        log_i("send \"%s\" as \"%s\" %d bytes gzip", file, format, size);
+        server->sendHeader("Content-Encoding", "gzip");
+        server->send_P(200, format, (PGM_P)content, size);
+      }
     }
   }
 
-  void serveHtml(void)  { serve(WEBSOCKET_URL,    "text/html",        HTML); }
-  void serveJs(void)    { serve(WEBSOCKET_JSURL,  "text/javascript",  JS);   }
-  void serveCss(void)   { serve(WEBSOCKET_CSSURL, "text/css",         CSS);  }
+  void serveHtml(void)  { serve(WEBSOCKET_URL,    WEBSOCKET_WWW_HTML_MIME, WEBSOCKET_WWW_HTML_ETAG, WEBSOCKET_WWW_HTML, sizeof(WEBSOCKET_WWW_HTML)); }
+  void serveJs(void)    { serve(WEBSOCKET_JSURL,  WEBSOCKET_WWW_JS_MIME,   WEBSOCKET_WWW_JS_ETAG,   WEBSOCKET_WWW_JS,   sizeof(WEBSOCKET_WWW_JS));   }
+  void serveCss(void)   { serve(WEBSOCKET_CSSURL, WEBSOCKET_WWW_CSS_MIME,  WEBSOCKET_WWW_CSS_ETAG,  WEBSOCKET_WWW_CSS,  sizeof(WEBSOCKET_WWW_CSS));  }
   
-  static void onMessage(WebsocketsClient &client, WebsocketsMessage message) {
+  /** Process a message from a client, text messages are commands of the control protocol:
+   *  "subscribe <channel|all> [<decimation>]" or "unsubscribe <channel|all>", anything else is 
+   *  echoed. Binary messages are injected to the GNSS. 
+   *  \param client   the client 
+   *  \param message  the message received
+   */
+  void onMessage(CLIENT& client, WebsocketsMessage message) {
     if (!message.isBinary()) {
       String data = message.data();
       log_i("string \"%s\" with %d bytes", data.c_str(), message.length()); 
-      data = "Echo from HPG solution:\r\n" + data;
-      client.send(data.c_str());
+      char cmd[16] = "";  // sscanf leaves them untouched on an empty message
+      char name[16] = "";
+      int decimation = 1;
+      int args = sscanf(data.c_str(), "%15s %15s %d", cmd, name, &decimation);
+      bool subscribe = (0 == strcmp(cmd, "subscribe"));
+      if ((2 <= args) && (subscribe || (0 == strcmp(cmd, "unsubscribe")))) {
+        uint32_t mask = 0;
+        for (int ch = CHANNEL_STATUS + 1; ch < CHANNEL_NUM; ch ++) {
+          if ((0 == strcmp(name, "all")) || (0 == strcmp(name, CHANNEL_LUT[ch]))) {
+            mask |= 1 << ch;
+            client.decimation[ch] = ((1 <= decimation) && (decimation <= 0xFFFF)) ? decimation : 1;
+            client.counter[ch] = 0;
+          }
+        }
+        if (0 == mask) {
+          clientStatus(client, String("Unknown channel \"") + name + "\"\r\n");
+        } else {
+          client.channels = subscribe ? (client.channels | mask) : (client.channels & ~mask);
+          updateChannels();
+          clientStatus(client, String(cmd) + " " + name + ((subscribe && (1 < decimation)) ? " decimation " + String(decimation) : "") + "\r\n");
+        }
+      } else if ((1 == args) && (0 == strcmp(cmd, "atstats"))) {
+        clientStatus(client, "AT command latency:\r\n" + UbxSerial.atStats());
+      } else {
+        clientStatus(client, "Echo from HPG solution:\r\n" + data);
+      }
     } else {
       log_i("binary %d bytes", message.length());
       // function is declared here to avoid include dependency
@@ -291,176 +679,13 @@ protected:
     }
   }
   
-  std::vector<WebsocketsClient> wsClients;  //!< list websocket clients connected
+  std::list<CLIENT> wsClients;              //!< list websocket clients connected with their send queues
   WebsocketsServer wsServer;                //!< websocket server listens for incoming connections 
+  TaskHandle_t wsTask;                      //!< the websocket task
   WiFiManager* pManager;                    //!< the wifi manager with its captive portal
-  bool connected;                           //!< wifi connected flag
 
-  static const char HTML[];   //!< the content of served file monitor.html
-  static const char CSS[];    //!< the content of served file monitor.css
-  static const char JS[];     //!< the content of served file monitor.js
 };
 
 WEBSOCKET Websocket;  //!< The global WEBSOCKET peripherial object
 
-// --------------------------------------------------------------------------------------
-// Resources served
-// --------------------------------------------------------------------------------------
-
-//! the content of served file monitor.html
-const char WEBSOCKET::HTML[] = R"(
-<!DOCTYPE html>
-<html>
-  <head>
-    <script src=")" WEBSOCKET_JSURL R"(" type="text/javascript"></script>
-    <link   href=")" WEBSOCKET_CSSURL R"("  type="text/css" rel="stylesheet" media="all" />
-    <script src="https://cdn.jsdelivr.net/npm/openlayers@4.6.5/dist/ol.js"  type="text/javascript"></script>
-    <link  href="https://cdn.jsdelivr.net/npm/openlayers@4.6.5/dist/ol.css" type="text/css" rel="stylesheet"/>
-    <title>)" WEBSOCKET_BUTTON R"(</title>
-    <meta charset='UTF-8'>
-  </head>
-  <body>
-    <h1>)" WEBSOCKET_BUTTON R"(</h1>
-    <div hidden id='map' class='map item' style="height:40vh"></div>
-    <div id='output' class='item'></div>
-    <input id='message' class='item' type='text' placeholder='Send a message' />
-  </body>
-</html>
-)";
-
-//! the content of served file monitor.css
-const char WEBSOCKET::CSS[] = R"(
-  body {
-    display: grid;
-    grid-gap: 1em;
-    margin: 0;
-    padding: 1em;
-    box-sizing: border-box;
-    font-family: 'Helvetica Neue', 'Helvetica', 'Arial', sans-serif;
-  }
-  h1 {
-    margin: 0;
-  }
-  input {
-    bo
-  }
-  .item {
-    padding: 0.2em;
-    border: 1pt solid;
-    font-size: 12pt;
-    font-family: monospace;
-  }
-  #map {
-    height: 40vh;
-  }
-  #output {
-    height: 35vh;
-    white-space: nowrap;
-    overflow: scroll;
-    resize: vertical;
-  }
-  #message {
-    width: 100%;
-    outline: none;
-    box-sizing: border-box;
-  }
-)";
-
-//! the content of served file monitor.js
-const char WEBSOCKET::JS[] = R"(
-  "use strict";
-  let map = null; 
-  let track = null;
-  let point = null;
-  let connected = false
-  let ws = null
-  let output = null
-  
-  function log(message, color = 'black') {
-    if (null != output) {
-      const el = document.createElement('div')
-      el.innerHTML = message
-      el.style.color = color
-      output.append(el)
-      output.scrollTop = output.scrollHeight
-    }
-  }
-
-  window.onload = function _onload() {
-    // create the map
-    let el = document.getElementById('map');
-    if (ol !== undefined) {
-      el.removeAttribute('hidden');
-      const pos = ol.proj.fromLonLat([8.565783, 47.284641])
-      track = new ol.Feature( { geometry: new ol.geom.LineString([]) } )
-      track.setStyle( new ol.style.Style({
-          stroke: new ol.style.Stroke({
-            color: 'rgba(255,110,89,0.7)', 
-            width: 3,
-            lineCap: 'round'
-          })
-        }) 
-      )
-      let svg = '<svg xmlns="http://www.w3.org/2000/svg" width="24" height="24" viewBox="0 0 24 24" fill="none" stroke="white" stroke-width="3" stroke-linecap="round" stroke-linejoin="round"><circle cx="12" cy="12" r="10"></circle><line x1="22" y1="12" x2="18" y2="12"></line><line x1="6" y1="12" x2="2" y2="12"></line><line x1="12" y1="6" x2="12" y2="2"></line><line x1="12" y1="22" x2="12" y2="18"></line></svg>';
-      let icon = new ol.style.Icon({ color:'#ff6e59', opacity: 1, src: 'data:image/svg+xml;utf8,' + svg,
-                   anchor: [0.5, 0.5], anchorXUnits: 'fraction', anchorYUnits: 'fraction', });
-      point = new ol.Feature( { geometry: new ol.geom.Point(pos) } )
-      point.setStyle( new ol.style.Style( { image: icon } ) );
-      map = new ol.Map({
-        target: 'map',
-        controls: ol.control.defaults().extend([ new ol.control.ScaleLine({ units: 'metric' }) ]),
-        layers: [
-          new ol.layer.Tile({
-            source: new ol.source.OSM()
-          }), 
-          new ol.layer.Vector({
-            source: new ol.source.Vector({
-              features: [point, track]
-            }),
-          })
-        ],
-        view: new ol.View({
-          center: ol.proj.fromLonLat(pos),
-          zoom: 16
-        })
-      });
-    } 
-
-    const message = document.querySelector('#message')
-    output = document.querySelector('#output')
-    const url = ((window.location.protocol == 'https:') ? 'wss:' : 'ws:') + '//' + window.location.host + ':8080'
-    ws = new WebSocket(url)
-    
-    ws.addEventListener('open', () => {
-      connected = true
-      log('Open', 'green')
-    })
-    ws.addEventListener('close', () => {
-      connected = false
-      log('Close', 'red')
-    })
-    ws.addEventListener('message', ({ data }) => {
-      if (typeof(data) == 'string') {
-        log(`${data}`)
-        //                     time        src     fix  car acc       lat          lon
-        const m = data.match(/^\d+:\d+:\d+ [\w-]+ (\S+) \w+ \d+\.\d+ (-?\d+\.\d+) (-?\d+\.\d+)/)
-        if (map && track && m) {
-          if (m[1] != "No") {
-            let pos = ol.proj.fromLonLat([Number(m[3]), Number(m[2])])
-            map.getView().setCenter(pos)
-            track.getGeometry().appendCoordinate(pos)
-            point.getGeometry().setCoordinates(pos)
-          }
-        }
-      }
-    })
-    message.addEventListener('keyup', ({ keyCode }) => {
-      if (connected && (keyCode === 13)) {
-        ws.send(message.value)
-      }
-    })
-    log(`Connecting to ${url} ...`, 'blue')
-  }
-)";
-
 #endif
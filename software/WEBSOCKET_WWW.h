@@ -0,0 +1,215 @@
+// Generated by www/generate.py from the files in the www folder, do not edit.
+
+#ifndef __WEBSOCKET_WWW_H__
+#define __WEBSOCKET_WWW_H__
+
+//! monitor.html, 699 bytes, 342 bytes compressed
+#define WEBSOCKET_WWW_HTML_MIME "text/html"
+#define WEBSOCKET_WWW_HTML_ETAG "\"cf5f398a57d5ca67\""
+const uint8_t WEBSOCKET_WWW_HTML[] PROGMEM = {
+  0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x9D,0x52,0x4D,0x4F,0x03,0x21,
+  0x10,0xBD,0xFB,0x2B,0x46,0x2E,0x9C,0x5C,0x34,0xA9,0xC6,0x98,0xDD,0xC6,0xC4,0x8F,
+  0x9B,0xD1,0xC4,0x7A,0xF0,0x88,0xCB,0x58,0xA8,0x2C,0x4B,0x60,0xBA,0x71,0xFF,0xBD,
+  0x2C,0xB4,0xB5,0x4D,0x4C,0x8C,0x9E,0x78,0xC0,0xBC,0x37,0xEF,0x0D,0xD4,0xC7,0xB7,
+  0x8F,0x37,0x8B,0xD7,0xA7,0x3B,0xD0,0xD4,0xD9,0xF9,0x51,0x5D,0x16,0x80,0x5A,0xA3,
+  0x54,0x13,0x48,0x30,0xB6,0xC1,0x78,0x82,0x18,0xDA,0x86,0x89,0xAE,0x77,0x86,0xFA,
+  0x50,0xAD,0x22,0x03,0x1A,0x3D,0x36,0x8C,0xF0,0x93,0xC4,0x4A,0x0E,0xB2,0xD4,0xB1,
+  0x79,0x2D,0x0A,0xDA,0xD0,0xAD,0x71,0x1F,0x69,0xD5,0x01,0xDF,0xF7,0xF8,0x6D,0x4C,
+  0x02,0xFB,0x0A,0xF9,0x20,0xA0,0x6D,0x58,0xA4,0xD1,0x62,0xD4,0x88,0xC4,0xA0,0x43,
+  0x65,0x64,0xC3,0xA4,0xB5,0x0C,0xC4,0x0F,0x7E,0x34,0x91,0x8F,0x57,0x42,0xB4,0xCA,
+  0x25,0x4B,0x0A,0xAD,0x19,0x42,0xE5,0x90,0x84,0xF3,0x9D,0xE8,0x3D,0x3A,0x2B,0x47,
+  0x0C,0xF1,0x7A,0x56,0x5D,0x54,0xE7,0x42,0x99,0x48,0xA2,0xB7,0xD9,0xFC,0x9F,0xDC,
+  0x17,0xF3,0xFF,0x6B,0x96,0x83,0xFD,0x16,0x74,0x9B,0x8D,0x0C,0x59,0x9C,0x3F,0x94,
+  0x21,0xD5,0xA2,0x6C,0xCB,0x55,0x87,0x24,0xA1,0xD5,0x32,0x44,0xA4,0x86,0xBF,0x2C,
+  0xEE,0x4F,0x2E,0x79,0x7E,0x2A,0xB1,0x7D,0xAB,0xFA,0xAD,0x57,0xE3,0xA6,0x5A,0x9F,
+  0x7D,0xAB,0x24,0x5C,0x0E,0x95,0x19,0x40,0x1B,0xA5,0xD0,0x81,0x51,0x0D,0xEF,0xA4,
+  0xE7,0xD0,0x5A,0x19,0x63,0xC6,0x60,0x08,0x3B,0x0E,0xD9,0x55,0x0A,0x8B,0x66,0xA9,
+  0xE9,0x6A,0x76,0x3A,0xE8,0x69,0x28,0x89,0xBA,0x27,0x32,0xB1,0xFB,0x35,0xF9,0x35,
+  0xED,0x04,0x32,0xF9,0xA0,0xD0,0xB8,0x74,0x5F,0x1A,0x61,0x8C,0x72,0x89,0x87,0xB5,
+  0x65,0x26,0x7C,0x9A,0x09,0x07,0x6F,0x65,0x8B,0xBA,0xB7,0x0A,0x43,0xC3,0x9F,0xD1,
+  0x29,0x90,0xB0,0x63,0x89,0x12,0xB3,0xA4,0x4B,0x71,0xF2,0x1F,0xFD,0x02,0xD8,0xE8,
+  0x98,0x2B,0xBB,0x02,0x00,0x00,
+};
+
+//! monitor.css, 549 bytes, 295 bytes compressed
+#define WEBSOCKET_WWW_CSS_MIME "text/css"
+#define WEBSOCKET_WWW_CSS_ETAG "\"3a20a76e41739ce5\""
+const uint8_t WEBSOCKET_WWW_CSS[] PROGMEM = {
+  0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x85,0x91,0xC1,0x6E,0x83,0x30,
+  0x10,0x44,0xEF,0xF9,0x8A,0x95,0xAA,0x2A,0x97,0x12,0x91,0xB4,0xBD,0x90,0x53,0x6F,
+  0x3D,0xF5,0x1F,0x0C,0x5E,0xF0,0x4A,0xC6,0x6B,0xD9,0x06,0x9A,0x56,0xF9,0xF7,0x1A,
+  0x6C,0x42,0x2A,0x55,0x2A,0x12,0x92,0x3D,0xB3,0xDA,0x79,0x03,0x00,0x35,0xCB,0x0B,
+  0x7C,0xEF,0x20,0x3E,0x92,0xBC,0xD5,0xE2,0x52,0x41,0xE7,0x48,0x9E,0x17,0x69,0x3E,
+  0x15,0x9D,0xB0,0x15,0x1C,0xB1,0x4F,0x52,0x2F,0x5C,0x47,0xA6,0x82,0x32,0x5D,0xAD,
+  0x90,0x92,0x4C,0x77,0x37,0x50,0xF3,0x67,0xE1,0xE9,0x6B,0x11,0x6B,0x76,0x12,0x5D,
+  0x11,0xA5,0xE4,0xB5,0x6C,0x42,0xD1,0x8A,0x9E,0x74,0x8C,0xD9,0xBF,0xA3,0x1E,0x31,
+  0x50,0x23,0xE0,0x03,0x07,0xDC,0x3F,0xDD,0x29,0xF3,0xE5,0xCD,0x91,0xD0,0xF1,0xE0,
+  0x85,0xF1,0x85,0x47,0x47,0xED,0xBC,0xE4,0x1A,0x5F,0x75,0xCC,0xC8,0xBF,0x60,0x66,
+  0x87,0x8C,0x1D,0x42,0x36,0x6B,0xCE,0xE2,0x81,0x02,0xF6,0x59,0xBC,0xF1,0x96,0x87,
+  0xD3,0x46,0x3C,0x53,0xC6,0x0A,0x36,0x80,0x67,0xBD,0x96,0x5F,0x60,0x63,0x13,0x8C,
+  0xCE,0xC9,0x86,0x3F,0x1A,0xF4,0x6C,0xD8,0x5B,0xD1,0xE0,0x1A,0xFF,0xD0,0x0B,0x9B,
+  0x83,0x14,0x52,0xA7,0x42,0x05,0x2F,0xE5,0xA8,0x6E,0x36,0x0F,0x61,0xE3,0x5B,0x27,
+  0x9E,0x5F,0xD3,0x04,0xC0,0xA4,0x22,0x69,0xB1,0x6C,0xAC,0xC0,0xF0,0xE4,0x84,0x4D,
+  0x06,0x8F,0xE8,0x5A,0xCD,0x53,0x05,0xBE,0x71,0xAC,0x75,0x52,0x1D,0x26,0xBA,0x68,
+  0xCE,0xDF,0x4C,0x6F,0x14,0xE8,0xBD,0xE8,0x30,0xE7,0x4C,0x24,0x83,0x8A,0x1D,0xCA,
+  0xF2,0x31,0x6F,0x1B,0x82,0x26,0xB3,0x44,0x18,0xFC,0xEF,0xA7,0x5D,0x77,0x3F,0x04,
+  0x5D,0x8F,0xDB,0x25,0x02,0x00,0x00,
+};
+
+//! monitor.js, 6076 bytes, 2398 bytes compressed
+#define WEBSOCKET_WWW_JS_MIME "text/javascript"
+#define WEBSOCKET_WWW_JS_ETAG "\"13c561f92753d409\""
+const uint8_t WEBSOCKET_WWW_JS[] PROGMEM = {
+  0x1F,0x8B,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xD5,0x58,0x6D,0x77,0xDA,0x3A,
+  0x12,0xFE,0x9E,0x5F,0xA1,0xE5,0xF6,0xD4,0xF6,0x86,0x98,0xD7,0x10,0x42,0x4B,0x7B,
+  0x12,0x4A,0xDB,0x9C,0x4B,0x92,0x9E,0x40,0x92,0x76,0x53,0xB6,0x31,0xB6,0x00,0xDF,
+  0x18,0x8B,0x95,0x65,0x08,0x9B,0xCB,0x7F,0xDF,0x19,0x49,0x36,0x36,0x21,0xD9,0xBB,
+  0x1F,0x37,0x27,0xD8,0xD2,0xCC,0xA3,0xD1,0x48,0x9A,0x19,0xCD,0x98,0x90,0x42,0x1C,
+  0x51,0x12,0x09,0xEE,0xBB,0xA2,0xF0,0x6E,0x8F,0x90,0x80,0x0A,0x32,0x73,0xE6,0xA4,
+  0x4D,0xC2,0x38,0x08,0xDE,0x11,0x4D,0x12,0xDC,0x71,0x1F,0x12,0xA2,0xA6,0xCD,0x99,
+  0x1F,0x8A,0x2D,0x9A,0xCB,0xC2,0x90,0xBA,0x82,0x7A,0x40,0x1F,0x3B,0x41,0x44,0x35,
+  0x7D,0x19,0x69,0xA0,0xEE,0xB3,0x58,0xCC,0x63,0xB1,0xA1,0xC1,0xFF,0x38,0x0E,0x5D,
+  0xE1,0xB3,0x90,0x04,0x6C,0x62,0xCE,0x68,0x14,0x39,0x13,0x5A,0x04,0x81,0x01,0xE3,
+  0x80,0x33,0x46,0x01,0x68,0x60,0x58,0xE4,0x09,0xA0,0x84,0xF8,0x63,0x62,0xE2,0x50,
+  0xF2,0xB7,0xB6,0x96,0x95,0x70,0x08,0xEA,0x10,0x09,0x42,0x03,0x18,0xE5,0x31,0x37,
+  0x9E,0xD1,0x50,0xD8,0x2E,0xA7,0x8E,0xA0,0xDD,0x80,0x62,0xCF,0x34,0x3C,0x7F,0x61,
+  0x58,0x1A,0x4E,0x03,0xDB,0x07,0xA5,0xF9,0xD7,0xC1,0x79,0x0F,0x86,0xE8,0x99,0x37,
+  0xCC,0x48,0xAC,0x02,0x6A,0x27,0x7A,0xC8,0xB7,0x66,0xAA,0x89,0x6D,0x67,0x3E,0xA7,
+  0xA1,0x67,0xD2,0xC0,0xCA,0xD3,0x23,0x97,0xB3,0x20,0x18,0x30,0xDC,0xCC,0x1C,0xE9,
+  0x2B,0xF5,0x27,0x53,0x21,0xC1,0xEB,0x3D,0xFC,0xC1,0xA3,0x54,0x22,0x1E,0x75,0x99,
+  0x47,0x89,0x98,0x52,0x32,0xF2,0x43,0x87,0xAF,0xC8,0x6D,0xF7,0xB4,0x7F,0xD9,0xF9,
+  0xBD,0x3B,0x68,0xB5,0x06,0xDD,0x5E,0xF7,0xBC,0x3B,0xB8,0xFA,0x91,0x51,0x50,0x2D,
+  0x34,0xE5,0xFC,0x3A,0x3F,0xF9,0x72,0xD6,0xC1,0xBD,0xFA,0xFA,0xED,0xCB,0xC0,0xD8,
+  0x01,0xB8,0xE9,0x5E,0xF5,0xCF,0x2E,0x2F,0x00,0x52,0xD9,0xC1,0xED,0x9F,0xFD,0xA3,
+  0x0B,0xAC,0xC3,0x72,0xCA,0xEB,0x5F,0x5E,0x5F,0x75,0x90,0x76,0x47,0x8C,0xDB,0xDE,
+  0xC9,0x85,0x51,0x24,0x46,0x6F,0xD0,0x95,0xAF,0xD3,0x93,0x8B,0x4F,0xD8,0xF8,0xBD,
+  0xFB,0xA3,0x8F,0xEF,0x54,0x57,0xEC,0x9C,0xF6,0xAE,0xBB,0x83,0xCB,0xCB,0xC1,0x57,
+  0xEC,0x1C,0x18,0x64,0x98,0x8A,0xFC,0x7C,0xF6,0x5D,0xC9,0xBB,0x60,0xC8,0xFB,0x74,
+  0x85,0xCF,0xAA,0x94,0x54,0xD3,0xCF,0x7D,0x45,0x1C,0x9C,0xE3,0x53,0xFE,0x32,0xE3,
+  0x3B,0x27,0x57,0x57,0x59,0x01,0x9F,0x03,0xE6,0x08,0xD9,0xF0,0x1F,0xA9,0xB7,0x41,
+  0xC3,0x7E,0xE2,0x46,0x06,0x4E,0x24,0x3A,0x8C,0x73,0x2A,0x4D,0xEB,0x64,0x42,0x09,
+  0x77,0x42,0x78,0xCA,0x9D,0x66,0x63,0x72,0x7D,0xFA,0xFD,0xE0,0xE2,0xE4,0xE6,0xE0,
+  0xDB,0xCD,0xA0,0x48,0x62,0x38,0x48,0x4E,0x46,0x2C,0x0E,0x3D,0xE2,0x87,0x24,0x82,
+  0xF3,0x08,0xBD,0xA8,0x28,0x6D,0x14,0x2D,0x2E,0x64,0x82,0x38,0x0B,0xC7,0x0F,0x9C,
+  0x51,0xB0,0xD9,0xFF,0xCE,0xE5,0xD5,0xD5,0xAF,0x93,0x2F,0x6A,0x9B,0x10,0x5A,0x24,
+  0x95,0x22,0xA9,0x16,0xC9,0x21,0x34,0xCA,0xF0,0x83,0x77,0x15,0xDE,0x35,0xF8,0xD5,
+  0xA1,0xDD,0x80,0xF7,0x31,0xD2,0x91,0x78,0x16,0x8E,0xFD,0xD0,0x17,0x2B,0xA9,0x73,
+  0xEA,0x01,0x82,0xA2,0xA1,0x0A,0xBE,0x32,0x3D,0x47,0x38,0x59,0x9B,0xC7,0xBE,0x3D,
+  0x5A,0x09,0xDA,0xA3,0xE1,0x44,0x4C,0xC9,0xFB,0xAD,0xF3,0xB3,0x08,0xA7,0x22,0xE6,
+  0x61,0xE2,0x57,0x89,0x92,0xDE,0x02,0x7D,0x8D,0x2E,0xC9,0x27,0x10,0x70,0xE3,0xD3,
+  0xA5,0x92,0x9C,0x41,0xCC,0x9C,0x89,0xEF,0x02,0xA8,0x0F,0xB1,0x20,0x9C,0xD8,0x63,
+  0xCE,0x66,0x9D,0xA9,0xC3,0x3B,0xB0,0x51,0xA6,0xB7,0xB0,0x27,0x54,0x5C,0x83,0xBB,
+  0x37,0xCD,0xB2,0x55,0x24,0xD9,0x7E,0x65,0xAB,0x5F,0xDD,0xEA,0xD7,0x2C,0x2B,0xD5,
+  0xDE,0x54,0x93,0x80,0xCF,0x6E,0x19,0xAD,0x45,0xFE,0xFC,0x93,0xE4,0xA6,0xA9,0x5B,
+  0x79,0x98,0x36,0x5D,0xEB,0xA5,0x05,0xCE,0x1D,0x0C,0x39,0xE6,0xC2,0x22,0xED,0x0F,
+  0x7A,0x0D,0xD0,0xB1,0x81,0xDC,0x17,0x0E,0x17,0x26,0x9C,0x87,0x51,0x36,0xB2,0x0B,
+  0x1E,0x07,0xCE,0x04,0xA3,0x52,0x76,0xD6,0xA6,0x02,0xE8,0x29,0x92,0x80,0x12,0xB1,
+  0x98,0xBB,0xB4,0x05,0x2D,0xE5,0x10,0x77,0xD9,0x21,0x87,0xD6,0x10,0x95,0x07,0x2B,
+  0x2F,0x6A,0xF8,0xD8,0x7F,0x6C,0xA9,0x16,0x18,0x7B,0x0E,0xDB,0xB0,0xC8,0x5B,0x72,
+  0x34,0x4C,0x80,0xAE,0xC3,0xB9,0x42,0xA2,0x55,0xE7,0x90,0x47,0x88,0xAC,0x0D,0x33,
+  0x22,0x2F,0x1F,0x24,0xB4,0x8C,0xDB,0x62,0x2A,0xDD,0xDF,0x12,0xD8,0x7C,0x8D,0x08,
+  0xE3,0x59,0xFF,0x46,0x22,0xB2,0x62,0x8E,0x53,0xBE,0x0B,0x4E,0x00,0xE6,0x0F,0x88,
+  0xC4,0x5E,0x73,0xF3,0x55,0xCA,0xB0,0x8C,0x8F,0x1F,0x95,0xFD,0xEA,0x21,0x60,0x21,
+  0x54,0xA9,0x77,0xFF,0xE6,0x69,0x03,0xAE,0x34,0xCC,0x0A,0xEC,0xA6,0xE0,0x31,0xB5,
+  0xD6,0x07,0x6F,0x9E,0x60,0x8B,0x73,0x27,0x57,0xA9,0x58,0xBB,0xE9,0x75,0xA0,0xDF,
+  0x27,0xC2,0x85,0x3F,0xDB,0x08,0x7F,0x06,0x3D,0x04,0x68,0x6B,0x07,0xBD,0xF1,0x02,
+  0xFD,0x28,0x2B,0xDA,0x1F,0x5C,0xDE,0x2A,0xD1,0x1B,0x4C,0xAD,0x6A,0x56,0x9A,0x5A,
+  0xE9,0x04,0x17,0x38,0x42,0x9F,0x93,0xC2,0x9D,0x49,0x58,0x35,0x59,0x1B,0xF9,0x3B,
+  0xA9,0xD0,0x83,0x23,0xB2,0xBF,0x61,0x83,0x35,0x37,0x35,0xFD,0x38,0x95,0xC2,0xC2,
+  0x5D,0x52,0x1A,0xAF,0x4A,0x39,0xDE,0x96,0x32,0x95,0x57,0x42,0x6B,0x4B,0x0A,0x86,
+  0x8C,0x8C,0x94,0x5A,0x5E,0x4A,0xBD,0xAC,0xE9,0xF5,0x54,0xCA,0x79,0xBF,0xD7,0x7A,
+  0xA6,0x4B,0xAD,0xFE,0xAA,0x94,0xCA,0x33,0x29,0x27,0xAE,0xBB,0x63,0xFF,0xEA,0xF9,
+  0x8D,0xA9,0x25,0xF0,0xC5,0x0B,0xF0,0xC6,0x2E,0x78,0x7A,0xDF,0x2D,0xFD,0xD0,0x63,
+  0x4B,0x9B,0x85,0x10,0xBF,0x65,0xB2,0x90,0xC4,0xBE,0x5F,0x8A,0x64,0x26,0x51,0x0F,
+  0x02,0xB9,0xBA,0xBC,0x65,0x3C,0x87,0xD4,0x44,0x52,0x31,0x87,0xC8,0xDF,0xF0,0x30,
+  0xB3,0xBE,0xDE,0x4F,0x57,0x67,0x9E,0x69,0x00,0xD2,0xB0,0xDE,0xA5,0xA1,0x87,0x61,
+  0xAA,0xD0,0x26,0x10,0xDA,0x29,0x44,0x5C,0xEA,0x6D,0xD2,0x05,0xB8,0xE2,0x39,0x9D,
+  0xB1,0x05,0x3D,0x11,0x10,0x36,0x46,0xB1,0xA0,0xA6,0x31,0xF5,0x3D,0x8F,0x86,0xC9,
+  0xF8,0x34,0xC6,0x30,0x8C,0x17,0x2C,0xB0,0xE7,0x9C,0xFD,0x21,0x23,0x64,0x8F,0x85,
+  0x3D,0x47,0x98,0x77,0x4D,0xFB,0xB0,0x71,0x78,0xD4,0xAC,0x41,0x84,0x3F,0xB2,0xAB,
+  0xCD,0x7A,0xA3,0x5E,0x19,0x26,0xD9,0x40,0x9A,0x3A,0x41,0xF4,0x85,0xB1,0x9F,0x61,
+  0x2D,0x31,0xA7,0x26,0x79,0x22,0x13,0xCA,0x64,0x94,0x6F,0x25,0x3C,0x24,0xD8,0x3D,
+  0x50,0x4F,0x07,0xB0,0xBB,0xA1,0x45,0xD6,0x24,0x27,0xC8,0x8E,0xA8,0xE8,0x63,0x46,
+  0x62,0x26,0x83,0x54,0x7E,0xA2,0x68,0xC9,0x9A,0x64,0xD4,0x12,0x9C,0x3D,0xD0,0xD6,
+  0x36,0x0C,0x89,0x39,0x1C,0x51,0x39,0x4D,0x8B,0x18,0x7C,0x32,0x72,0xCC,0xEA,0xE1,
+  0x61,0xB1,0x02,0xF7,0x56,0xF3,0xB8,0x58,0xB6,0x8F,0x2C,0xB8,0x51,0x73,0xD8,0xA5,
+  0xEF,0x89,0x69,0x8B,0xA4,0xA7,0xAF,0x9D,0x00,0x74,0xEE,0x38,0x73,0x94,0x81,0xB7,
+  0xA7,0x91,0x61,0xAE,0xAD,0xBD,0x4D,0x33,0x91,0x95,0xD0,0xF0,0x18,0xA3,0xC5,0x04,
+  0x73,0x96,0xF7,0xF8,0x7E,0x9C,0x05,0x61,0xD4,0x2E,0x4C,0x85,0x98,0xB7,0x4A,0xA5,
+  0xE5,0x72,0x69,0x2F,0x6B,0x36,0xE3,0x93,0x52,0xB5,0x5C,0x2E,0x97,0x00,0x51,0x50,
+  0x0A,0xB4,0x0B,0xD5,0x7A,0x41,0x3B,0x8D,0x6A,0x2F,0xE0,0x4E,0x3B,0x65,0x8F,0xED,
+  0x42,0x19,0x42,0x64,0xB5,0x4E,0x90,0x36,0xF6,0x83,0xA0,0x5D,0x08,0x59,0x48,0x0B,
+  0x7A,0x37,0xDA,0x85,0xE5,0xD4,0x17,0x69,0xF7,0x40,0x0B,0xAB,0xA5,0x04,0x5C,0x88,
+  0xEB,0xCC,0xDB,0x05,0xB9,0x8E,0x1C,0xF9,0x0F,0x48,0x77,0x13,0xFA,0x87,0xF7,0xAE,
+  0xCF,0xDD,0x00,0xF2,0x08,0x98,0xB1,0x52,0x2D,0x10,0x77,0xA5,0xDE,0x1C,0x5E,0x65,
+  0x60,0x97,0x14,0xFF,0xC3,0x7B,0x1C,0x49,0x1E,0x2B,0xA0,0x24,0x70,0x57,0x15,0x85,
+  0x7A,0xAC,0xC2,0xBB,0x09,0xFD,0xAA,0xEC,0x03,0x1C,0x61,0x19,0x70,0x23,0x8F,0xAD,
+  0xBE,0x02,0xAD,0x68,0xB9,0x0D,0x2D,0x56,0x63,0x5F,0x83,0x56,0xAB,0x79,0x2C,0xA8,
+  0x92,0x82,0x71,0x93,0x3F,0x18,0xEF,0x32,0xE7,0xE3,0x83,0xF1,0x6F,0xCC,0x57,0x99,
+  0xD1,0x19,0xD0,0xCC,0x27,0x6D,0x38,0xC6,0x6F,0xE3,0x71,0x83,0x1E,0x1E,0x83,0xA9,
+  0xB0,0xB9,0xE3,0x42,0x36,0xD3,0xC2,0x0C,0x28,0xE2,0x10,0x16,0x0C,0x4C,0x33,0x5A,
+  0x3E,0xDC,0xFB,0x14,0x25,0xEF,0xC3,0x01,0xBF,0x8B,0xC5,0xB8,0x59,0x34,0x20,0x0A,
+  0x01,0x21,0x6F,0x46,0xFA,0xCF,0x09,0xDD,0x29,0x1A,0xE4,0x5D,0xD9,0x86,0x7C,0x09,
+  0x1E,0xC3,0xA2,0xA6,0x7D,0xBF,0x86,0x64,0x29,0x02,0xB1,0x63,0xF0,0x05,0x0C,0x17,
+  0x46,0xC2,0xF9,0xB1,0x83,0xB3,0x4E,0xFD,0x37,0x2D,0x55,0xFE,0xA2,0x0F,0x7E,0x43,
+  0xBC,0x09,0xFE,0x9E,0xF5,0x3F,0x29,0xE4,0x75,0xFF,0x03,0x81,0x72,0xAD,0x2D,0xB5,
+  0x6B,0x30,0x96,0xA4,0x3A,0xE8,0xAA,0x4A,0x0D,0x3A,0x77,0xE6,0x19,0x27,0x84,0x0C,
+  0x05,0xC2,0x17,0x28,0x8F,0x41,0x6B,0xB3,0x25,0x20,0x02,0xCC,0x2F,0x80,0x55,0xC1,
+  0x08,0xDD,0xB1,0x21,0x7E,0x39,0x71,0x20,0x22,0xD3,0xB2,0xE9,0xA3,0xC0,0xC2,0xE3,
+  0x2E,0x11,0x9A,0x40,0xFA,0xAE,0x13,0x50,0x0C,0x23,0x70,0x44,0xB1,0xDE,0x16,0x5C,
+  0xA4,0xEF,0x1A,0xE8,0x83,0x43,0x6B,0x33,0x45,0xE0,0xAC,0x28,0x07,0xFE,0x5D,0xE6,
+  0x1C,0xB4,0x34,0xC9,0xB2,0x07,0x7E,0xB0,0x1D,0x2E,0x92,0x74,0x28,0x59,0xBF,0xEC,
+  0xDA,0x97,0xFD,0x73,0xD3,0xCA,0xF9,0x7D,0x2E,0x72,0xE4,0x84,0xDE,0x40,0x3A,0xCE,
+  0xF8,0x5F,0x12,0xBB,0x13,0x0A,0x09,0x91,0x3A,0x41,0xD4,0x5C,0x1E,0x4B,0x51,0x45,
+  0xC7,0x61,0x0E,0xB6,0xB6,0x8A,0xBB,0x03,0xD1,0x70,0x43,0xC7,0xB8,0x91,0xCE,0x29,
+  0x13,0xE3,0xEC,0x54,0x2E,0x5C,0x27,0x94,0xB7,0x76,0xC5,0x7C,0x34,0x8E,0xAC,0xF8,
+  0x7F,0x33,0x36,0x03,0xBB,0x6F,0xEC,0x3D,0x9B,0x2F,0x31,0xC3,0x35,0xD9,0xCB,0xE6,
+  0xDB,0xAA,0x8C,0xCB,0x5E,0x61,0xFF,0x8A,0x29,0x5F,0xF5,0x21,0xF7,0x97,0x4B,0x36,
+  0x7E,0xD3,0x10,0x9D,0xB5,0xA6,0x25,0xF3,0x8B,0x78,0x85,0xC8,0x25,0xB9,0x31,0xC7,
+  0x4B,0xD2,0x34,0xF5,0x75,0x1B,0x30,0xD7,0x41,0xE7,0xC0,0xD5,0x08,0x06,0xEE,0x4B,
+  0xE0,0x4E,0x34,0x30,0xDC,0x46,0x2D,0xA8,0xAD,0x3F,0x12,0x63,0x19,0x41,0x8B,0xB4,
+  0xB0,0x81,0x94,0x7D,0x62,0x94,0x4A,0xE8,0xAB,0xDB,0x02,0xA6,0x0C,0xA4,0x03,0xB7,
+  0xD5,0x2C,0x37,0xCB,0x2A,0xDE,0xAB,0x1A,0x1F,0x76,0xF2,0x96,0x8E,0xFA,0xCC,0x7D,
+  0xA0,0xC2,0x84,0xE9,0x2D,0xCD,0xB3,0x55,0x4D,0x3B,0x58,0xCD,0x71,0xCD,0x06,0xA4,
+  0xBE,0xCE,0x6A,0x14,0x8F,0xC7,0x94,0xAB,0xD1,0x09,0xCC,0xF1,0xBC,0xEE,0x02,0x56,
+  0xD7,0xF3,0x23,0xB0,0x6E,0x0A,0xEB,0x62,0x50,0x5E,0x83,0x37,0x9B,0x32,0xB5,0xCF,
+  0x14,0xF9,0xE9,0x87,0x06,0x4C,0x33,0xD2,0x6C,0x6C,0x62,0x1A,0x97,0x6A,0x80,0x31,
+  0xE1,0x14,0x2F,0x71,0xCD,0x92,0x15,0xA1,0x1F,0x41,0xA5,0x00,0xBB,0x0E,0x49,0xC6,
+  0x8A,0x44,0x53,0x06,0x3A,0x63,0x5A,0x91,0x16,0x5C,0x50,0xEC,0x31,0x58,0x03,0x88,
+  0x1D,0x43,0xB9,0x8F,0x2C,0xEE,0x2C,0x31,0x13,0x76,0xB4,0x14,0xD0,0x30,0x42,0xA7,
+  0x33,0xE2,0x30,0x8A,0x47,0x50,0xCF,0xFB,0x23,0x4A,0x9C,0x20,0x48,0xA7,0x49,0x01,
+  0x1B,0x76,0x2A,0x5D,0x83,0xD6,0xD6,0xCB,0x8B,0x75,0x03,0x16,0xD1,0x57,0x57,0x9B,
+  0x7C,0x56,0x49,0x97,0xDB,0xD1,0x43,0x0C,0x0E,0x05,0xF0,0x7F,0x9F,0x21,0xB1,0x2A,
+  0x98,0xE3,0x49,0xAE,0x0C,0x63,0x42,0x66,0xAE,0xA4,0xCC,0x84,0x12,0x38,0x12,0x10,
+  0x5C,0x29,0x94,0xC9,0x27,0x78,0x5A,0xA7,0xF2,0xB4,0x36,0x89,0x53,0x62,0x63,0x62,
+  0x86,0x67,0x90,0x2F,0x59,0x53,0x08,0x4A,0x13,0xB3,0xEC,0xA0,0x64,0x98,0x32,0x7E,
+  0xF5,0x15,0x07,0xAC,0x50,0xCC,0x6C,0x5D,0xA3,0x48,0x3B,0x44,0x1B,0x34,0xD3,0xEA,
+  0xF8,0x39,0x5F,0x0E,0xFF,0x00,0x35,0x74,0x84,0xC8,0x7B,0xD9,0x7D,0xFF,0xE6,0x69,
+  0x83,0x5A,0x47,0xF7,0x99,0x29,0x71,0xA3,0xEE,0x25,0x1B,0x0B,0x8F,0x35,0x91,0x4D,
+  0x15,0x62,0x74,0x07,0x4A,0x2C,0xDD,0xC2,0xB2,0x4C,0x37,0x31,0x15,0xB6,0x05,0x93,
+  0xDF,0x16,0xA0,0x92,0xD5,0x54,0x28,0x1C,0x52,0xE2,0x71,0x4A,0x04,0xA7,0x78,0x46,
+  0xC4,0x84,0x3C,0xA5,0xD6,0xAD,0xF5,0x9B,0x27,0xD0,0x73,0x7D,0x9F,0x8D,0x93,0xB8,
+  0x41,0x78,0x35,0xBC,0x7D,0xAB,0x33,0x45,0x68,0x98,0x4A,0x1F,0x2C,0xF5,0xF0,0x33,
+  0x87,0x95,0xDF,0xBE,0xE4,0xEB,0xDB,0x4B,0xC9,0xA8,0x52,0xA6,0x48,0x94,0xA6,0x43,
+  0x2B,0x37,0x14,0xA6,0xC2,0x54,0x59,0x46,0x3A,0x0B,0x2F,0xB3,0x8E,0x0C,0x71,0x32,
+  0x9C,0xE5,0x80,0x2A,0xDB,0x04,0xE8,0x17,0x7D,0x43,0x02,0x5C,0x7D,0xE9,0xEA,0x30,
+  0xC6,0x3D,0x70,0x66,0x48,0x94,0x9F,0x8D,0x52,0x77,0x64,0x7E,0x14,0x4E,0x92,0x0E,
+  0x89,0xB6,0xC7,0xAC,0xF7,0xB6,0x5B,0x6B,0x48,0xC9,0x23,0xAA,0x2C,0x07,0xA2,0x05,
+  0x1B,0xEB,0xAF,0x20,0x18,0xAA,0x22,0x99,0x18,0x1B,0xD9,0x0D,0xD1,0x47,0x8B,0x18,
+  0xA8,0x01,0xA5,0x45,0xC3,0x9D,0x0C,0x35,0x7F,0x74,0xEB,0x8B,0xA9,0x69,0x7C,0xE2,
+  0x0C,0xD4,0xF6,0x54,0x78,0x63,0xF2,0xF3,0x8F,0x0C,0x70,0xFA,0x83,0x62,0x2A,0x07,
+  0xE2,0xC3,0xAE,0x3F,0xB4,0x97,0xF4,0x8A,0xE2,0x6E,0x52,0x8E,0xCB,0xEA,0x9D,0x38,
+  0xAE,0x9B,0x5E,0xA4,0x22,0x6B,0x6D,0xE1,0x96,0x8F,0xA0,0x8B,0x48,0xCD,0x66,0x8E,
+  0x70,0xA7,0x66,0xE9,0x9F,0x3F,0xBD,0xFD,0x96,0xFE,0x91,0xBB,0x9F,0xCB,0x83,0xE1,
+  0x3E,0x31,0x7F,0xF6,0xF7,0x2D,0xF2,0x73,0xB9,0x4F,0x80,0xF8,0xD3,0x46,0x8E,0x79,
+  0xF0,0x31,0x69,0x5B,0xB9,0x4E,0x29,0xEF,0x61,0xDB,0x06,0xB4,0xE5,0x70,0x12,0x72,
+  0x57,0x19,0xA2,0x41,0x15,0x2E,0x58,0xE1,0x7F,0xB3,0xA7,0x8B,0x78,0x36,0x02,0x0B,
+  0x99,0xDD,0xD5,0x20,0x73,0x20,0x69,0xAF,0x3A,0xB4,0xFE,0x0F,0x6D,0x2B,0x1B,0x1E,
+  0x75,0x24,0xDC,0x11,0x23,0x1F,0xE8,0x2A,0x9E,0xAB,0x08,0x09,0x4D,0xFC,0x06,0xB6,
+  0x23,0x48,0x6E,0x82,0x32,0xBA,0x6C,0x82,0x6B,0x83,0x99,0x56,0x6A,0x39,0x97,0x4D,
+  0xAE,0x84,0x64,0xBE,0x85,0x13,0x40,0x5D,0xBC,0x4B,0x23,0x69,0xCB,0x1D,0x25,0x17,
+  0xEC,0x9C,0x08,0x06,0x71,0x04,0x2E,0xD1,0x35,0xB1,0x6D,0x1B,0x8C,0x1B,0x8C,0x36,
+  0x56,0xF9,0xC0,0x7A,0xEF,0x3F,0x70,0x82,0xC1,0x42,0xBC,0x17,0x00,0x00,
+};
+
+#endif // __WEBSOCKET_WWW_H__
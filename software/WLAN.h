@@ -20,6 +20,7 @@
 #include <WiFi.h>
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
+#include <lwip/sockets.h>
 #include <ArduinoMqttClient.h>
 #include <WiFiManager.h>
 #if defined(ARDUINO_UBLOX_NORA_W10) && defined(ESP_ARDUINO_VERSION) && (ESP_ARDUINO_VERSION < ESP_ARDUINO_VERSION_VAL(2,0,5))
@@ -28,6 +29,7 @@
 #include <SparkFun_u-blox_SARA-R5_Arduino_Library.h>
 
 #include "HW.h"
+#include "TIMELINE.h"
 #include "CONFIG.h"
 #include "WEBSOCKET.h"
 #include "GNSS.h"
@@ -38,6 +40,7 @@ const int WLAN_INIT_RETRY         =       60000;  //!< delay between detect/auto
 const int WLAN_RECONNECT_RETRY    =       60000;  //!< delay between re-connection attempts for wifi
 const int WLAN_PROVISION_RETRY    =       10000;  //!< delay between provisioning attempts, provisioning may consume data
 const int WLAN_CONNECT_RETRY      =       10000;  //!< delay between server connection attempts to correction severs
+const int WLAN_NTRIP_READ_SIZE    =        1024;  //!< size of the reusable buffer used to read the NTRIP stream
 
 const char* WLAN_TASK_NAME        =      "Wlan";  //!< Wlan task name
 const int WLAN_STACK_SIZE         =      6*1024;  //!< Wlan task stack size
@@ -49,6 +52,9 @@ const int LED_STACK_SIZE          =      1*1024;  //!< led task stack size
 const int LED_TASK_PRIO           =           2;  //!< led task priority
 const int LED_TASK_CORE           =           1;  //!< led task MCU code
 
+//! the configuration groups that are cached by the WLAN task, a change will force a reconnect of the correction client
+const uint32_t WLAN_CONFIG_GROUPS = CONFIG::GROUP_SOURCE | CONFIG::GROUP_MQTT | CONFIG::GROUP_NTRIP;
+
 extern class WLAN Wlan;  //!< Forward declaration of class
 
 class ConfigWiFiManagerParameter : public WiFiManagerParameter {
@@ -70,6 +76,9 @@ public:
   WLAN() : mqttClient(mqttWifiClient) {
     state = INIT;
     wasOnline = false;
+    configGeneration = Config.getGeneration(WLAN_CONFIG_GROUPS) - 1; // force reading the configuration
+    connectGeneration = configGeneration;
+    topicsGeneration = Config.getTopicsGeneration() - 1;
     
     pinInit();
     ledInit();
@@ -238,8 +247,6 @@ protected:
     if (save) {
       Config.save();
       updateConfigParams();
-      Config.wlanReconnect = true;
-      Config.lteReconnect = true;
     }
   }
 
@@ -248,11 +255,12 @@ protected:
   // -----------------------------------------------------------------------
 
   std::vector<String> topics;       //!< vector with current subscribed topics
+  uint32_t topicsGeneration;        //!< the generation of the topic set that topics is in sync with
   WiFiClientSecure mqttWifiClient;  //!< the secure wifi client used for MQTT 
   MqttClient mqttClient;            //!< the secure MQTT client 
   
   /** Try to provision the PointPerfect to that we can start the MQTT server. This involves: 
-   *  1) HTTPS request is made to AWS to GET theri ROOT CA
+   *  1) HTTPS request is made to AWS to GET theri ROOT CA, skipped if the AWSTRUST_ROOTCA is bundled
    *  2) HTTPS request to Thingstream POSTing the device tocken to get the credentials and client cert, key and ID
    *  \return the client id assigned to this board
    */
@@ -260,14 +268,18 @@ protected:
     String id; 
     String ztpReq = Config.ztpRequest();
     if (ztpReq.length()) {
-      // Fetch the AWS Root CA
+      // Fetch the AWS Root CA, unless it is bundled
       HTTPClient http;
-      http.begin(AWSTRUST_ROOTCAURL);
-      http.setConnectTimeout(5000);
-      log_i("HTTP AWS \"%s\" get", AWSTRUST_ROOTCAURL);
-      int httpResponseCode = http.GET();
-      String rootCa = http.getString();
-      http.end();
+      String rootCa = AWSTRUST_ROOTCA;
+      int httpResponseCode = HTTP_CODE_OK;
+      if (0 == rootCa.length()) {
+        http.begin(AWSTRUST_ROOTCAURL);
+        http.setConnectTimeout(5000);
+        log_i("HTTP AWS \"%s\" get", AWSTRUST_ROOTCAURL);
+        httpResponseCode = http.GET();
+        rootCa = http.getString();
+        http.end();
+      }
       if (httpResponseCode != HTTP_CODE_OK) {
         log_e("HTTP AWS response error %d %s", httpResponseCode, rootCa.c_str());
       } else {
@@ -297,10 +309,10 @@ protected:
    *  \param id  the client ID for this device
    */
   bool mqttConnect(String id) {
-    String broker = Config.getValue(CONFIG_VALUE_BROKERHOST);
-    String rootCa = Config.getValue(CONFIG_VALUE_ROOTCA);
-    String cert = Config.getValue(CONFIG_VALUE_CLIENTCERT);
-    String key = Config.getValue(CONFIG_VALUE_CLIENTKEY);
+    String broker = Config.getValue(CONFIG::KEY_BROKERHOST);
+    String rootCa = Config.getValue(CONFIG::KEY_ROOTCA);
+    String cert = Config.getValue(CONFIG::KEY_CLIENTCERT);
+    String key = Config.getValue(CONFIG::KEY_CLIENTKEY);
     mqttWifiClient.setCACert(rootCa.c_str());
     mqttWifiClient.setCertificate(cert.c_str());
     mqttWifiClient.setPrivateKey(key.c_str());
@@ -333,6 +345,7 @@ protected:
       mqttClient.unsubscribe(topic);
     }
     topics.clear();
+    topicsGeneration = Config.getTopicsGeneration() - 1; // force subscribing on the next connect
     if (mqttClient.connected()) {
       log_i("disconnect");
       mqttClient.stop();
@@ -342,29 +355,41 @@ protected:
   /** The MQTT task is responsible for:
    *  1) subscribing to topics
    *  2) unsubscribing from topics 
+   *  This is only done if the topic set changed.
    */
   void mqttTask(void) {
-    std::vector<String> newTopics = Config.getTopics();
-    // filter out the common ones that need no change 
-    for (auto rit = topics.rbegin(); rit != topics.rend(); rit = std::next(rit)) {
-      String topic = *rit;
-      std::vector<String>::iterator pos = std::find(newTopics.begin(), newTopics.end(), topic);
-      if (pos != topics.end()) {
-        newTopics.erase(pos);
-      } else {
-        log_i("unsubscribe \"%s\"", topic.c_str());
-        if (mqttClient.unsubscribe(topic)) {
-          topics.erase(std::next(rit).base());
+    if (topicsGeneration == Config.getTopicsGeneration()) {
+      return;
+    }
+    uint32_t generation;
+    std::shared_ptr<const std::vector<String>> newTopics = Config.getTopics(&generation);
+    bool ok = true;
+    // unsubscribe the topics that are not needed anymore 
+    for (auto it = topics.begin(); it != topics.end(); ) {
+      if (newTopics->end() == std::find(newTopics->begin(), newTopics->end(), *it)) {
+        log_i("unsubscribe \"%s\"", it->c_str());
+        if (mqttClient.unsubscribe(*it)) {
+          it = topics.erase(it);
+          continue;
         }
+        ok = false;
       }
+      it = std::next(it);
     }
-    for(int n = 0; n < newTopics.size(); n ++) {
-      String topic = newTopics[n];
-      log_i("subscribe \"%s\"", topic.c_str());
-      if (mqttClient.subscribe(topic)) {
-        topics.push_back(topic);
+    // subscribe the new topics 
+    for (auto it = newTopics->begin(); it != newTopics->end(); it = std::next(it)) {
+      if (topics.end() == std::find(topics.begin(), topics.end(), *it)) {
+        log_i("subscribe \"%s\"", it->c_str());
+        if (mqttClient.subscribe(*it)) {
+          topics.push_back(*it);
+        } else {
+          ok = false;
+        }
       }
     } 
+    if (ok) {
+      topicsGeneration = generation;
+    }
   }
   
   /** The MQTT callback processes is responsible for reading the data
@@ -373,31 +398,77 @@ protected:
   void onMQTT(int messageSize) {
     if (messageSize) {
       String topic = mqttClient.messageTopic();
-      GNSS::MSG msg;
-      msg.data = new uint8_t[messageSize];
-      if (NULL != msg.data) {
-        msg.size = mqttClient.read(msg.data, messageSize);
-        if (msg.size == messageSize) {
-          msg.source = GNSS::SOURCE::WLAN;
-          log_i("topic \"%s\" with %d bytes", topic.c_str(), msg.size); 
-          if (topic.startsWith(MQTT_TOPIC_KEY_FORMAT)) {
-            msg.source = GNSS::SOURCE::KEYS;
-            if (Config.setValue(CONFIG_VALUE_KEY, msg.data, msg.size)) {
+      bool keys = topic.startsWith(MQTT_TOPIC_KEY_FORMAT);
+      if (keys || topic.equals(MQTT_TOPIC_FREQ)) {
+        // keys and frequencies are small and needed in a contiguous buffer
+        uint8_t buf[GNSS_CHUNK_SIZE];
+        int len = (messageSize <= sizeof(buf)) ? mqttClient.read(buf, messageSize) : 0;
+        if (len == messageSize) {
+          log_i("topic \"%s\" with %d bytes", topic.c_str(), len); 
+          if (keys) {
+            if (Config.setValue(CONFIG::KEY_PPKEY, buf, len)) {
               Config.save();
             }
-          }
-          if (topic.equals(MQTT_TOPIC_FREQ)) {
-            Config.setLbandFreqs(msg.data, msg.size);
-            delete [] msg.data; // not injecting to queue to the GNSS, so we need to delete the buffer here
+            Gnss.inject(buf, len, GNSS::SOURCE::KEYS);
           } else {
-            Gnss.inject(msg); // we do not have to delete msg.data here, this is done by receiving side of the queue 
+            Config.setLbandFreqs(buf, len);
           }
         } else { 
-          log_e("topic \"%s\" with %d bytes failed reading after %d", topic.c_str(), messageSize, msg.size); 
-          delete [] msg.data;
+          log_e("topic \"%s\" with %d bytes failed reading after %d", topic.c_str(), messageSize, len); 
         }
       } else {
-        log_e("topic \"%s\" with %d bytes failed, no memory", topic.c_str(), msg.size);
+        // stream the payload into a chain of pool chunks, no large contiguous buffer is needed 
+        GNSS::MSG msg;
+        msg.source = GNSS::SOURCE::WLAN;
+        msg.size = 0;
+        GNSS::CHUNK** tail = &msg.chunks;
+        while (msg.size < messageSize) {
+          GNSS::CHUNK* chunk = Gnss.chunkAlloc();
+          if (NULL == chunk) {
+            break;
+          }
+          *tail = chunk;
+          tail = &chunk->next;
+          int len = messageSize - msg.size;
+          len = mqttClient.read(chunk->data, (len < GNSS_CHUNK_SIZE) ? len : GNSS_CHUNK_SIZE);
+          if (0 >= len) {
+            break;
+          }
+          chunk->size = len;
+          msg.size += len;
+        }
+        if ((msg.size < messageSize) && (0 < mqttClient.available())) {
+          // the pool is exhausted, fall back to the heap like GNSS::inject does instead of dropping corrections
+          uint8_t* data = new uint8_t[messageSize];
+          if (NULL != data) {
+            size_t pos = 0;
+            for (GNSS::CHUNK* chunk = msg.chunks; NULL != chunk; chunk = chunk->next) {
+              memcpy(&data[pos], chunk->data, chunk->size);
+              pos += chunk->size;
+            }
+            Gnss.msgFree(msg);
+            msg.data = data;
+            msg.size = pos;
+            while (msg.size < messageSize) {
+              int len = mqttClient.read(&data[msg.size], messageSize - msg.size);
+              if (0 >= len) {
+                break;
+              }
+              msg.size += len;
+            }
+          }
+        }
+        if (msg.size == messageSize) {
+          log_i("topic \"%s\" with %d bytes", topic.c_str(), msg.size); 
+          Gnss.inject(msg); // the chunks are returned to the pool by the receiving side of the queue 
+        } else { 
+          log_e("topic \"%s\" with %d bytes failed reading after %d", topic.c_str(), messageSize, msg.size); 
+          Gnss.msgFree(msg);
+        }
+      }
+      // skip anything we could not read, to stay in sync with the stream
+      while (0 < mqttClient.available()) {
+        mqttClient.read();
       }
     }
   }
@@ -410,88 +481,336 @@ protected:
   // NTRIP / RTCM
   // -----------------------------------------------------------------------
   
+  typedef enum { 
+    NTRIP_IDLE = 0,         //!< no connection
+    NTRIP_CONNECTING,       //!< waiting for the non-blocking connect to complete
+    NTRIP_HEADER,           //!< request sent, parsing the response line and headers
+    NTRIP_DATA              //!< receiving correction data
+  } NTRIP_STATE;            //!< states of the NTRIP client 
+  
+  NTRIP_STATE ntripState = NTRIP_IDLE; //!< state of the NTRIP client
+  int ntripFd = -1;                   //!< the socket during the non-blocking connect
+  WiFiClient ntripWifiClient;         //!< the plain client, takes over the socket once connected
+  WiFiClientSecure ntripSecureClient; //!< the secure client used for https casters
+  Client* ntripClient = NULL;         //!< the client in use, NULL while idle or connecting 
+  String ntripRequest;                //!< the GET request, sent once connected
+  String ntripLine;                   //!< the response line or header currently parsed
+  bool ntripFirstLine;                //!< the response line was not yet parsed
+  bool ntripChunked;                  //!< the caster uses chunked transfer encoding (NTRIP v2)
+  int32_t ntripChunkLeft;             //!< bytes left in the current chunk, NTRIP_CHUNK_SIZE or NTRIP_CHUNK_CRLF  
+  int32_t ntripTtagTimeout;           //!< time tag (millis()) when the connect or response times out
   int32_t ntripGgaMs;                 //!< time tag (millis()) of next GGA to be sent
-  HTTPClient ntripHttpClient;
-    
-  /** Connect to a NTRIP server
-   *  \param url  the server:port/mountpoint to connect
-   *  \return     connection success
+  uint8_t ntripBuf[WLAN_NTRIP_READ_SIZE]; //!< the reusable buffer the NTRIP stream is read into
+  
+  static const int32_t NTRIP_CHUNK_SIZE = -1; //!< ntripChunkLeft: parsing the chunk size line
+  static const int32_t NTRIP_CHUNK_CRLF = -2; //!< ntripChunkLeft: skipping the CRLF after a chunk
+  
+  /** Start the connection to a NTRIP server, plain connections are made without blocking the 
+   *  task, the connection is then completed by ntripPoll.
+   *  \param url  the http(s)://server:port/mountpoint to connect
+   *  \return     connection started
    */
   bool ntripConnect(String url) {
-    String user = Config.getValue(CONFIG_VALUE_NTRIP_USERNAME);
-    String pwd = Config.getValue(CONFIG_VALUE_NTRIP_PASSWORD);
-    String ver = Config.getValue(CONFIG_VALUE_NTRIP_VERSION);
-    String gga = Config.getValue(CONFIG_VALUE_NTRIP_GGA);
-    ntripHttpClient.begin(url);
-    ntripHttpClient.useHTTP10(NTRIP_USE_HTTP10);
-    ntripHttpClient.setAuthorization(user.c_str(), pwd.c_str());
-    ntripHttpClient.setUserAgent(CONFIG_DEVICE_TITLE);
-    if (0 < ver.length()) ntripHttpClient.addHeader(NTRIP_HEADER_VERSION, ver.c_str());
-    if (0 < gga.length()) ntripHttpClient.addHeader(NTRIP_HEADER_GGA, gga.c_str());
-    int httpCode = ntripHttpClient.GET();
-    if (httpCode == HTTP_CODE_OK) {
-      log_i("url \"%s\" user \"%s\" pwd \"%s\" ver \"%s\" connected", 
-            url.c_str(), user.c_str(), pwd.c_str(), ver);
-      ntripGgaMs = millis();
-      return true;
-    } else {
-      String err = HTTPClient::errorToString(httpCode);
-      log_e("url \"%s\" user \"%s\" pwd \"%s\" ver \"%s\" failed code %d(%s)", 
-            url.c_str(), user.c_str(), pwd.c_str(), ver, httpCode, err.c_str());
-      ntripHttpClient.end();
+    ntripStop();
+    int pos = 0;
+    int toPos = url.indexOf("://", pos);
+    String proto = (toPos > pos) ? url.substring(pos,toPos) : "http";
+    pos = (toPos > pos) ? toPos + 3 : pos; 
+    toPos = url.indexOf(':', pos);
+    if(toPos < 0) toPos = url.indexOf('/', pos);
+    String server = (toPos > pos) ? url.substring(pos,toPos) : "";
+    pos = (toPos > pos) ? toPos + 1 : pos; 
+    toPos = url.indexOf('/', pos);
+    uint16_t port = (toPos > pos) ? url.substring(pos,toPos).toInt() : NTRIP_SERVER_PORT;
+    pos = (toPos > pos) ? toPos + 1 : pos; 
+    String mntpnt = url.substring(pos);
+    if ((0 == server.length()) || (0 == mntpnt.length())) {
+      log_e("url \"%s\" invalid", url.c_str());
+      return false;
+    }
+    // prepare the request
+    String user = Config.getValue(CONFIG::KEY_NTRIP_USERNAME);
+    String pwd = Config.getValue(CONFIG::KEY_NTRIP_PASSWORD);
+    String ver = Config.getValue(CONFIG::KEY_NTRIP_VERSION);
+    String gga = Config.getValue(CONFIG::KEY_NTRIP_GGA);
+    String auth;
+    if (0 < user.length() && 0 < pwd.length()) {
+      auth = base64::encode(user + ":" + pwd);
+    }                    
+    ntripRequest = "GET /" + mntpnt + (NTRIP_USE_HTTP10 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n");
+    if (0 < auth.length()) ntripRequest += "Authorization: Basic " + auth + "\r\n";
+    if (0 < ver.length())  ntripRequest += NTRIP_HEADER_VERSION ": " + ver + "\r\n";
+    if (0 < gga.length())  ntripRequest += NTRIP_HEADER_GGA ": " + gga + "\r\n";
+    ntripRequest += "Host: " + server + ":" + port + "\r\n"
+                    "User-Agent: " CONFIG_DEVICE_TITLE "\r\n"
+                    "Accept: */*\r\n"
+                    "Connection: close\r\n"
+                    "\r\n";
+    log_i("url \"%s\" user \"%s\" pwd \"%s\" ver \"%s\" connecting", 
+            url.c_str(), user.c_str(), pwd.c_str(), ver.c_str());
+    ntripTtagTimeout = millis() + NTRIP_CONNECT_TIMEOUT;
+    if (proto.equalsIgnoreCase("https")) {
+      // the secure client has no non-blocking connect, the TLS handshake is done here
+      ntripSecureClient.setInsecure();
+      if (!ntripSecureClient.connect(server.c_str(), port, NTRIP_CONNECT_TIMEOUT)) {
+        log_e("server \"%s:%d\" connect failed", server.c_str(), port);
+        return false;
+      }
+      ntripClient = &ntripSecureClient;
+      return ntripSend();
+    }
+    IPAddress ip;
+    if (!WiFi.hostByName(server.c_str(), ip)) {
+      log_e("server \"%s\" dns lookup failed", server.c_str());
+      return false;
+    }
+    ntripFd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (0 > ntripFd) {
+      log_e("socket failed, errno %d", errno);
+      return false;
+    }
+    fcntl(ntripFd, F_SETFL, fcntl(ntripFd, F_GETFL, 0) | O_NONBLOCK);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = (uint32_t)ip;
+    addr.sin_port = htons(port);
+    if ((0 != connect(ntripFd, (struct sockaddr*)&addr, sizeof(addr))) && (EINPROGRESS != errno)) {
+      log_e("server \"%s:%d\" connect failed, errno %d", server.c_str(), port, errno);
+      close(ntripFd);
+      ntripFd = -1;
+      return false;
+    }
+    ntripState = NTRIP_CONNECTING;
+    return true;
+  }
+
+  /** Send the request once the client is connected and start parsing the response
+   *  \return  success
+   */
+  bool ntripSend(void) {
+    size_t wrote = ntripClient->print(ntripRequest);
+    if (wrote != ntripRequest.length()) {
+      log_e("request %d bytes, failed", ntripRequest.length());
       return false;
     }
+    log_d("request \"%s\"", ntripRequest.c_str());
+    ntripRequest = "";
+    ntripLine = "";
+    ntripFirstLine = true;
+    ntripChunked = false;
+    ntripChunkLeft = NTRIP_CHUNK_SIZE;
+    ntripState = NTRIP_HEADER;
+    return true;
   }
   
   /** Stop and cleanup the NTRIP connection 
    */
   void ntripStop(void)
   {
-    if (ntripHttpClient.connected()) {
+    if (0 <= ntripFd) {
+      close(ntripFd);
+      ntripFd = -1;
+    }
+    if (NULL != ntripClient) {
       log_i("disconnect");
-      ntripHttpClient.end();
+      ntripClient->stop();
+      ntripClient = NULL;
     }
+    ntripState = NTRIP_IDLE;
   } 
+
+  /** Parse a line of the response, the first line is the status, then the headers follow.
+   *  \param line  the line without CR LF
+   *  \return      false if the response is not acceptable 
+   */
+  bool ntripParseLine(const String& line) {
+    if (ntripFirstLine) {
+      ntripFirstLine = false;
+      // NTRIP v1 casters answer with "ICY 200 OK" and the data follows immediately, 
+      // v2 casters with a regular "HTTP/1.x 200 OK" and headers 
+      if (line.equals("ICY 200 OK")) {
+        log_i("connected, \"%s\"", line.c_str());
+        ntripState = NTRIP_DATA;
+        ntripGgaMs = millis();
+      } else if (line.startsWith("HTTP/") && (0 < line.indexOf(" 200 "))) {
+        log_d("response \"%s\"", line.c_str());
+      } else {
+        // this includes the "SOURCETABLE 200 OK" response to an unknown mountpoint
+        log_e("response \"%s\", failed", line.c_str());
+        return false;
+      }
+    } else if (0 == line.length()) {
+      log_i("connected, %s", ntripChunked ? "chunked" : "plain");
+      ntripState = NTRIP_DATA;
+      ntripGgaMs = millis();
+    } else {
+      log_d("header \"%s\"", line.c_str());
+      String header = line;
+      header.toLowerCase();
+      if (header.startsWith("transfer-encoding:") && (0 < header.indexOf("chunked"))) {
+        ntripChunked = true;
+      }
+    }
+    return true;
+  }
+
+  /** Remove the chunked transfer encoding in place. 
+   *  \param buf  the received data, the payload is moved to the front 
+   *  \param len  the number of bytes received
+   *  \param end  set to true if the last chunk was found, the payload before it is still returned
+   *  \return     the number of payload bytes
+   */
+  int ntripDechunk(uint8_t* buf, int len, bool& end) {
+    int out = 0;
+    for (int i = 0; i < len; ) {
+      if (NTRIP_CHUNK_SIZE == ntripChunkLeft) {
+        char ch = buf[i++];
+        if (ch == '\n') {
+          ntripChunkLeft = strtol(ntripLine.c_str(), NULL, 16); // ignores any chunk extension
+          ntripLine = "";
+          if (0 == ntripChunkLeft) {
+            log_i("last chunk, end of stream");
+            end = true;
+            break;
+          }
+        } else if ((ch != '\r') && (ntripLine.length() < 16)) {
+          ntripLine += ch;
+        }
+      } else if (NTRIP_CHUNK_CRLF == ntripChunkLeft) {
+        if (buf[i++] == '\n') {
+          ntripChunkLeft = NTRIP_CHUNK_SIZE;
+        }
+      } else {
+        int n = (len - i < ntripChunkLeft) ? (len - i) : ntripChunkLeft;
+        memmove(&buf[out], &buf[i], n);
+        out += n;
+        i += n;
+        ntripChunkLeft -= n;
+        if (0 == ntripChunkLeft) {
+          ntripChunkLeft = NTRIP_CHUNK_CRLF;
+        }
+      }
+    }
+    return out;
+  }
   
-  /** The NTRIP task is responsible for:
-   *  1) reading NTRIP data from the wifi and inject it into the GNSS receiver.
-   *  2) sending a GGA from time to time to allow VRS services to adjust their correction stream 
+  /** The NTRIP poll is called on every loop of the task and is responsible for:
+   *  1) completing the connection and parsing the response
+   *  2) reading NTRIP data from the wifi and inject it into the GNSS receiver.
+   *  3) sending a GGA from time to time to allow VRS services to adjust their correction stream 
+   *  \return  false if the connection failed or was closed
    */
-  void ntripTask(void)
+  bool ntripPoll(void)
   {
-    Stream &stream = ntripHttpClient.getStream();
-    int messageSize = stream.available();
-    if (0 < messageSize) {
-      GNSS::MSG msg;
-      msg.data = new uint8_t[messageSize];
-      if (NULL != msg.data) {
-        msg.size = stream.readBytes(msg.data, messageSize);
-        if (msg.size == messageSize) {
-          msg.source = GNSS::SOURCE::WLAN;
-          log_i("read %d bytes", messageSize);
-          Gnss.inject(msg);
-        } else {
-          log_e("read %d bytes failed reading after %d", messageSize, msg.size); 
-          delete [] msg.data;
+    int32_t now = millis();
+    if (NTRIP_CONNECTING == ntripState) {
+      fd_set fdset;
+      FD_ZERO(&fdset);
+      FD_SET(ntripFd, &fdset);
+      struct timeval tv = { 0, 0 };
+      if (0 < select(ntripFd + 1, NULL, &fdset, NULL, &tv)) {
+        int err = 0;
+        socklen_t errLen = sizeof(err);
+        getsockopt(ntripFd, SOL_SOCKET, SO_ERROR, &err, &errLen);
+        if (0 != err) {
+          log_e("connect failed, error %d", err);
+          return false;
         }
-      } else {
-        log_e("read %d bytes failed, no memory",  messageSize);
+        // hand over the connected socket to the wifi client
+        ntripWifiClient = WiFiClient(ntripFd);
+        ntripFd = -1;
+        ntripClient = &ntripWifiClient;
+        if (!ntripSend()) {
+          return false;
+        }
+      } else if (0 >= (ntripTtagTimeout - now)) {
+        log_e("connect timeout");
+        return false;
       }
     }
-    // send the GGA message
-    long now = millis();
-    if (ntripGgaMs - now <= 0) {
-      String gga = Config.getValue(CONFIG_VALUE_NTRIP_GGA);
-      int len = gga.length();
-      if (0 < len) {
-        int wrote = stream.print(gga + "\r\n");
-        if (wrote == len + 2) {
-          log_i("write \"%s\\r\\n\" %d bytes", gga.c_str(), wrote);
-          ntripGgaMs = now + NTRIP_GGA_RATE;
-        } else
-          log_e("write \"%s\\r\\n\" %d bytes, failed", gga.c_str(), wrote);
+    if (NTRIP_HEADER == ntripState) {
+      while ((NTRIP_HEADER == ntripState) && (0 < ntripClient->available())) {
+        char ch = ntripClient->read();
+        if (ch == '\n') {
+          if (!ntripParseLine(ntripLine)) {
+            return false;
+          }
+          ntripLine = "";
+        } else if ((ch != '\r') && (ntripLine.length() < 256)) {
+          ntripLine += ch;
+        }
+      }
+      if ((NTRIP_HEADER == ntripState) && (0 >= (ntripTtagTimeout - now))) {
+        log_e("response timeout");
+        return false;
       }
     }
+    if (NTRIP_DATA == ntripState) {
+      int messageSize = ntripClient->available();
+      int total = 0;
+      bool end = false;
+      while (!end && (0 < messageSize)) {
+        int size = (messageSize < sizeof(ntripBuf)) ? messageSize : sizeof(ntripBuf);
+        int len = ntripClient->read(ntripBuf, size);
+        if (len != size) {
+          log_e("read %d bytes failed reading after %d", size, len); 
+          break;
+        }
+        messageSize -= len;
+        len = ntripChunked ? ntripDechunk(ntripBuf, len, end) : len;
+        if (0 < len) {
+          // the GNSS copies the data into its chunk pool, so the buffer can be reused 
+          Gnss.inject(ntripBuf, len, GNSS::SOURCE::WLAN);
+          total += len;
+        }
+      }
+      if (0 < total) {
+        log_i("read %d bytes", total);
+      }
+      if (end) {
+        return false;
+      }
+      // send the GGA message
+      if (ntripGgaMs - now <= 0) {
+        String gga = Config.getValue(CONFIG::KEY_NTRIP_GGA);
+        int len = gga.length();
+        if (0 < len) {
+          int wrote = ntripClient->print(gga + "\r\n");
+          if (wrote == len + 2) {
+            log_i("write \"%s\\r\\n\" %d bytes", gga.c_str(), wrote);
+            ntripGgaMs = now + NTRIP_GGA_RATE;
+          } else
+            log_e("write \"%s\\r\\n\" %d bytes, failed", gga.c_str(), wrote);
+        }
+      }
+    }
+    return (NTRIP_CONNECTING == ntripState) || ntripClient->connected() || (0 < ntripClient->available());
+  }
+
+  /** Wait for data on the NTRIP socket or until the timeout expires, the task is woken up as 
+   *  soon as data is received so that corrections are injected without delay. 
+   *  \param timeout  the maximum time to wait in ms
+   */
+  void ntripWait(int timeout) {
+    int fd = (NTRIP_CONNECTING == ntripState) ? ntripFd : 
+             (ntripClient == &ntripWifiClient) ? ntripWifiClient.fd() : -1;
+    if (0 <= fd) {
+      fd_set fdset;
+      FD_ZERO(&fdset);
+      FD_SET(fd, &fdset);
+      struct timeval tv = { timeout / 1000, (timeout % 1000) * 1000 };
+      if (NTRIP_CONNECTING == ntripState) {
+        select(fd + 1, NULL, &fdset, NULL, &tv);
+      } else {
+        select(fd + 1, &fdset, NULL, NULL, &tv);
+      }
+      // clear any notification, we will check the configuration anyway
+      ulTaskNotifyTake(pdTRUE, 0);
+    } else {
+      // sleep, but wake up early if the configuration changes
+      ulTaskNotifyTake(pdTRUE, timeout);
+    }
   }
 
   // -----------------------------------------------------------------------
@@ -641,6 +960,11 @@ protected:
       log_i("state change %d(%s)", value, STATE_LUT[value].name);
       ledSet(STATE_LUT[value].pattern);
       state = value;
+      if (value == ONLINE) {
+        Timeline.mark(TIMELINE::WLAN);
+      } else if ((value == MQTT) || (value == NTRIP)) {
+        Timeline.mark(TIMELINE::SERVICE);
+      }
     }
     ttagNextTry = millis() + delay; 
   }
@@ -656,6 +980,7 @@ protected:
    *  and where the code decides what actions to perform.  
    */
   void task(void) {
+    Config.subscribe(NULL, WLAN_CONFIG_GROUPS);
     portalInit();  
     setState(SEARCHING);
     
@@ -680,12 +1005,18 @@ protected:
         ttagNextTry = now;
       }
       wasOnline = online;
-      Websocket.poll();
+      // only re-read the configuration if it was changed, and react immediately
+      uint32_t generation = Config.getGeneration(WLAN_CONFIG_GROUPS);
+      if (configGeneration != generation) {
+        configGeneration = generation;
+        id     = Config.getValue(CONFIG::KEY_CLIENTID);
+        ntrip  = Config.getValue(CONFIG::KEY_NTRIP_SERVER);
+        useSrc = Config.getValue(CONFIG::KEY_USESOURCE);
+        ttagNextTry = now;
+      }
       if (0 >= (ttagNextTry - now)) {
         ttagNextTry = now + WLAN_1S_RETRY;
-        String id     = Config.getValue(CONFIG_VALUE_CLIENTID);
-        String ntrip  = Config.getValue(CONFIG_VALUE_NTRIP_SERVER);
-        String useSrc = Config.getValue(CONFIG_VALUE_USESOURCE);
+        bool reconnect = (connectGeneration != configGeneration);
         bool useWlan  = (-1 != useSrc.indexOf("WLAN"));
         bool useNtrip = useWlan && useSrc.startsWith("NTRIP:");
         bool useMqtt  = useWlan && useSrc.startsWith("PointPerfect:");
@@ -712,7 +1043,6 @@ protected:
             }
             break;
           case ONLINE:
-            Config.wlanReconnect = false;
             if (useMqtt) {
               if (0 == id.length()) {
                 ttagNextTry = now + WLAN_PROVISION_RETRY;
@@ -721,6 +1051,7 @@ protected:
               // we may now have a id if ZTP was sucessful
               if (0 < id.length()){
                 ttagNextTry = now + WLAN_CONNECT_RETRY;
+                connectGeneration = configGeneration;
                 if (mqttConnect(id)) {
                   setState(MQTT);
                 }
@@ -728,6 +1059,7 @@ protected:
             } else if (useNtrip) {
               if (0 < ntrip.length()) {
                 ttagNextTry = now + WLAN_CONNECT_RETRY;
+                connectGeneration = configGeneration;
                 if (ntripConnect(ntrip)) {
                   setState(NTRIP);
                 }
@@ -735,7 +1067,7 @@ protected:
             }
             break;
           case MQTT:
-            if (!useMqtt || (0 == id.length()) || !mqttClient.connected() || Config.wlanReconnect) {
+            if (!useMqtt || (0 == id.length()) || !mqttClient.connected() || reconnect) {
               mqttStop();
               setState(ONLINE, WLAN_1S_RETRY);
             } else {
@@ -743,20 +1075,29 @@ protected:
             }
             break;
           case NTRIP: 
-            if (!useNtrip || (0 == ntrip.length()) || !ntripHttpClient.connected() || Config.wlanReconnect) {
+            if (!useNtrip || (0 == ntrip.length()) || (NTRIP_IDLE == ntripState) || reconnect) {
               ntripStop();
               setState(ONLINE, WLAN_1S_RETRY);
-            } else {
-              ntripTask();
             }
             break;
           default:
             break;
         }
       }
-      vTaskDelay(50);
+      // the NTRIP client is serviced on every loop, not just on the state machine tick
+      if ((NTRIP == state) && (NTRIP_IDLE != ntripState) && !ntripPoll()) {
+        ntripStop();
+        setState(ONLINE, WLAN_1S_RETRY);
+      }
+      ntripWait(50);
     }
   }
+
+  String id;                    //!< the PointPerfect client id, cached from the configuration
+  String ntrip;                 //!< the NTRIP server, cached from the configuration
+  String useSrc;                //!< the correction source, cached from the configuration
+  uint32_t configGeneration;    //!< the generation of the cached configuration
+  uint32_t connectGeneration;   //!< the generation of the configuration when the connection was established
 };
 
 WLAN Wlan; //!< The global WLAN peripherial object
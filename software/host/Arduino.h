@@ -0,0 +1,596 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HOST_ARDUINO_H__
+#define __HOST_ARDUINO_H__
+
+/** Host replacement of the ESP32 Arduino core for the subset used by LTE.h and the files it
+ *  includes. FreeRTOS tasks run as threads, the UART of the modem is the pty served by
+ *  tools/modemsim.py and the FFS is a directory. Everything is header only, the host build
+ *  is a single translation unit (main.cpp) like the sketch.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cerrno>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+
+// -----------------------------------------------------------------------
+// core version and attributes
+// -----------------------------------------------------------------------
+
+#define ESP_ARDUINO_VERSION_VAL(major, minor, patch) (((major) << 16) | ((minor) << 8) | (patch))
+#define ESP_ARDUINO_VERSION       ESP_ARDUINO_VERSION_VAL(2, 0, 17)
+#define HW_FLOWCTRL_CTS_RTS       3
+#define SERIAL_8N1                0x800001c
+#define PROGMEM
+#define IRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define F(x)                      x
+#define configASSERT(x)           if (!(x)) { fprintf(stderr, "assert %s:%d %s\n", __FILE__, __LINE__, #x); abort(); }
+
+// -----------------------------------------------------------------------
+// time
+// -----------------------------------------------------------------------
+
+//! the time base of millis() and micros(), set on first use like the reset of the ESP32
+inline std::chrono::steady_clock::time_point hostStart(void) {
+  static std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return start;
+}
+inline unsigned long millis(void) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - hostStart()).count();
+}
+inline unsigned long micros(void) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart()).count();
+}
+inline void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+inline void yield(void) {
+  std::this_thread::yield();
+}
+
+// -----------------------------------------------------------------------
+// logging, same format as the esp32-hal-log with the time prepended
+// -----------------------------------------------------------------------
+
+#ifndef HOST_LOG_LEVEL
+ #define HOST_LOG_LEVEL 4 //!< 1 error, 2 warning, 3 info, 4 debug, 5 verbose
+#endif
+
+//! serialize the log lines of all tasks
+inline std::mutex& hostLogMutex(void) {
+  static std::mutex mutex;
+  return mutex;
+}
+inline void hostLog(int level, char letter, const char* func, const char* format, ...) __attribute__((format(printf, 4, 5)));
+inline void hostLog(int level, char letter, const char* func, const char* format, ...) {
+  if (level <= HOST_LOG_LEVEL) {
+    std::lock_guard<std::mutex> lock(hostLogMutex());
+    fprintf(stderr, "%8lu [%c] %s(): ", millis(), letter, func);
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+  }
+}
+#define log_e(format, ...)  hostLog(1, 'E', __FUNCTION__, format, ##__VA_ARGS__)
+#define log_w(format, ...)  hostLog(2, 'W', __FUNCTION__, format, ##__VA_ARGS__)
+#define log_i(format, ...)  hostLog(3, 'I', __FUNCTION__, format, ##__VA_ARGS__)
+#define log_d(format, ...)  hostLog(4, 'D', __FUNCTION__, format, ##__VA_ARGS__)
+#define log_v(format, ...)  hostLog(5, 'V', __FUNCTION__, format, ##__VA_ARGS__)
+
+// -----------------------------------------------------------------------
+// GPIO, the levels of the input pins are set by main.cpp to what the modem drives
+// -----------------------------------------------------------------------
+
+#define LOW                       0
+#define HIGH                      1
+#define INPUT                     0x01
+#define OUTPUT                    0x03
+#define INPUT_PULLUP              0x05
+#define SOC_GPIO_PIN_COUNT        40
+
+enum { RX = 3, TX = 1, SS = 5, SCK = 18, MISO = 19, MOSI = 23 };
+
+//! the level of each pin
+inline uint8_t* hostPins(void) {
+  static uint8_t pins[SOC_GPIO_PIN_COUNT] = { 0 };
+  return pins;
+}
+inline void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin; (void)mode;
+}
+inline void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin < SOC_GPIO_PIN_COUNT) hostPins()[pin] = val;
+}
+inline int digitalRead(uint8_t pin) {
+  return (pin < SOC_GPIO_PIN_COUNT) ? hostPins()[pin] : LOW;
+}
+
+// -----------------------------------------------------------------------
+// String
+// -----------------------------------------------------------------------
+
+/** Arduino String on top of std::string, the std::string data pointer is the first member,
+ *  so that a String passed to a printf style function by mistake still prints.
+ */
+class String {
+public:
+  String() {}
+  String(const char* str) : s(str ? str : "") {}
+  String(const std::string& str) : s(str) {}
+  explicit String(char ch) : s(1, ch) {}
+  explicit String(int val, unsigned char base = 10) : s(number(val, base)) {}
+  explicit String(unsigned int val, unsigned char base = 10) : s(number(val, base)) {}
+  explicit String(long val, unsigned char base = 10) : s(number(val, base)) {}
+  explicit String(unsigned long val, unsigned char base = 10) : s(number(val, base)) {}
+  explicit String(double val, unsigned int decimals = 2) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, val);
+    s = buf;
+  }
+
+  unsigned int length(void) const { return s.size(); }
+  const char* c_str(void) const { return s.c_str(); }
+  bool reserve(unsigned int size) { s.reserve(size); return true; }
+  bool isEmpty(void) const { return s.empty(); }
+
+  bool concat(const String& str) { s += str.s; return true; }
+  bool concat(const char* str, unsigned int len) { s.append(str, len); return true; }
+  String& operator += (const String& str) { s += str.s; return *this; }
+  String& operator += (const char* str) { s += str; return *this; }
+  String& operator += (char ch) { s += ch; return *this; }
+  String& operator += (int val) { s += number(val, 10); return *this; }
+  String& operator += (unsigned int val) { s += number(val, 10); return *this; }
+  String& operator += (long val) { s += number(val, 10); return *this; }
+  String& operator += (unsigned long val) { s += number(val, 10); return *this; }
+
+  bool equals(const String& str) const { return s == str.s; }
+  bool equals(const char* str) const { return s == (str ? str : ""); }
+  bool equalsIgnoreCase(const String& str) const {
+    return (s.size() == str.s.size()) && std::equal(s.begin(), s.end(), str.s.begin(),
+              [](char a, char b) { return tolower(a) == tolower(b); });
+  }
+  bool startsWith(const String& str) const { return 0 == s.compare(0, str.s.size(), str.s); }
+  bool endsWith(const String& str) const {
+    return (s.size() >= str.s.size()) && (0 == s.compare(s.size() - str.s.size(), str.s.size(), str.s));
+  }
+  bool operator == (const String& str) const { return s == str.s; }
+  bool operator == (const char* str) const { return equals(str); }
+  bool operator != (const String& str) const { return s != str.s; }
+  bool operator < (const String& str) const { return s < str.s; }
+
+  char charAt(unsigned int index) const { return (index < s.size()) ? s[index] : 0; }
+  char operator [] (unsigned int index) const { return charAt(index); }
+  char& operator [] (unsigned int index) { return s[index]; }
+
+  int indexOf(char ch, unsigned int from = 0) const { return pos(s.find(ch, from)); }
+  int indexOf(const String& str, unsigned int from = 0) const { return pos(s.find(str.s, from)); }
+  int lastIndexOf(char ch) const { return pos(s.rfind(ch)); }
+  int lastIndexOf(const String& str) const { return pos(s.rfind(str.s)); }
+  String substring(unsigned int from) const { return (from < s.size()) ? String(s.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    return (from < s.size()) ? String(s.substr(from, to - from)) : String();
+  }
+  void remove(unsigned int index) { if (index < s.size()) s.erase(index); }
+  void remove(unsigned int index, unsigned int count) { if (index < s.size()) s.erase(index, count); }
+  void trim(void) {
+    size_t from = s.find_first_not_of(" \t\r\n");
+    size_t to = s.find_last_not_of(" \t\r\n");
+    s = (from == std::string::npos) ? "" : s.substr(from, to - from + 1);
+  }
+  void replace(const String& find, const String& with) {
+    for (size_t at = s.find(find.s); find.s.size() && (at != std::string::npos); at = s.find(find.s, at + with.s.size())) {
+      s.replace(at, find.s.size(), with.s);
+    }
+  }
+  void toLowerCase(void) { for (auto& ch : s) ch = tolower(ch); }
+  void toUpperCase(void) { for (auto& ch : s) ch = toupper(ch); }
+  long toInt(void) const { return atol(s.c_str()); }
+  double toDouble(void) const { return atof(s.c_str()); }
+
+  std::string s; //!< the string
+
+protected:
+  static int pos(size_t p) { return (std::string::npos == p) ? -1 : (int)p; }
+  template<typename T> static std::string number(T val, unsigned char base) {
+    char buf[72];
+    if (10 == base) {
+      snprintf(buf, sizeof(buf), std::is_signed<T>::value ? "%lld" : "%llu", (long long)val);
+    } else {
+      unsigned long long v = (unsigned long long)val;
+      char* p = &buf[sizeof(buf) - 1];
+      *p = '\0';
+      do { *--p = "0123456789abcdefghijklmnopqrstuvwxyz"[v % base]; v /= base; } while (v);
+      return p;
+    }
+    return buf;
+  }
+};
+inline String operator + (const String& a, const String& b)       { String r(a); r += b; return r; }
+inline String operator + (const String& a, const char* b)         { String r(a); r += b; return r; }
+inline String operator + (const char* a, const String& b)         { String r(a); r += b; return r; }
+inline String operator + (const String& a, char b)                { String r(a); r += b; return r; }
+inline String operator + (const String& a, int b)                 { String r(a); r += b; return r; }
+inline String operator + (const String& a, unsigned int b)        { String r(a); r += b; return r; }
+inline String operator + (const String& a, long b)                { String r(a); r += b; return r; }
+inline String operator + (const String& a, unsigned long b)       { String r(a); r += b; return r; }
+inline String operator + (const String& a, unsigned short b)      { String r(a); r += (unsigned int)b; return r; }
+
+// -----------------------------------------------------------------------
+// Print and Stream
+// -----------------------------------------------------------------------
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t ch) = 0;
+  virtual size_t write(const uint8_t* ptr, size_t size) {
+    size_t n = 0;
+    while ((n < size) && write(ptr[n])) n ++;
+    return n;
+  }
+  size_t write(const char* str) { return write((const uint8_t*)str, strlen(str)); }
+  size_t write(const char* ptr, size_t size) { return write((const uint8_t*)ptr, size); }
+  size_t print(const char* str) { return write(str); }
+  size_t print(const String& str) { return write(str.c_str(), str.length()); }
+  virtual void flush(void) {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available(void) = 0;
+  virtual int read(void) = 0;
+  virtual int peek(void) { return -1; }
+  String readString(void) {
+    String str;
+    int ch;
+    while (0 <= (ch = read())) str += (char)ch;
+    return str;
+  }
+};
+
+// -----------------------------------------------------------------------
+// HardwareSerial on a pty
+// -----------------------------------------------------------------------
+
+/** The UART of the modem is the pty of tools/modemsim.py, the baudrate and flow control
+ *  settings are ignored. The pty name is set with HardwareSerial::setPort() before begin.
+ */
+class HardwareSerial : public Stream {
+public:
+  HardwareSerial(int uart_nr) : _uart_nr(uart_nr), fd(-1), rxLen(0), rxPos(0) {}
+  virtual ~HardwareSerial() { end(); }
+
+  static void setPort(const char* name) { portName() = name; }
+
+  void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1) {
+    (void)baud; (void)config; (void)rxPin; (void)txPin;
+    if ((0 > fd) && portName().length()) {
+      fd = open(portName().c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+      if (0 <= fd) {
+        struct termios tio;
+        if (0 == tcgetattr(fd, &tio)) {
+          cfmakeraw(&tio);
+          tcsetattr(fd, TCSANOW, &tio);
+        }
+      } else {
+        fprintf(stderr, "port \"%s\" open failed\n", portName().c_str());
+      }
+    }
+  }
+  void end(void) {
+    if (0 <= fd) {
+      close(fd);
+      fd = -1;
+    }
+    rxLen = rxPos = 0;
+  }
+  bool setPins(int8_t rxPin, int8_t txPin, int8_t ctsPin = -1, int8_t rtsPin = -1) { return true; }
+  bool setHwFlowCtrlMode(uint8_t mode = HW_FLOWCTRL_CTS_RTS, uint8_t threshold = 64) { return true; }
+  size_t setRxBufferSize(size_t size) { return size; }
+
+  int available(void) override {
+    if ((rxPos == rxLen) && (0 <= fd)) {
+      ssize_t len = ::read(fd, rxBuf, sizeof(rxBuf));
+      rxPos = 0;
+      rxLen = (0 < len) ? len : 0;
+    }
+    return rxLen - rxPos;
+  }
+  int read(void) override {
+    return (0 < available()) ? rxBuf[rxPos ++] : -1;
+  }
+  int peek(void) override {
+    return (0 < available()) ? rxBuf[rxPos] : -1;
+  }
+  size_t write(uint8_t ch) override {
+    return write(&ch, 1);
+  }
+  size_t write(const uint8_t* ptr, size_t size) override {
+    size_t n = 0;
+    while ((0 <= fd) && (n < size)) {
+      ssize_t len = ::write(fd, &ptr[n], size - n);
+      if (0 < len) {
+        n += len;
+      } else {
+        delay(1); // the pty buffer is full
+      }
+    }
+    return n;
+  }
+  using Print::write;
+  operator bool() const { return 0 <= fd; }
+
+protected:
+  static std::string& portName(void) {
+    static std::string name;
+    return name;
+  }
+  int _uart_nr;             //!< the uart number
+  int fd;                   //!< the pty
+  uint8_t rxBuf[256];       //!< the data read from the pty
+  int rxLen;                //!< the size of the data in rxBuf
+  int rxPos;                //!< the read position in rxBuf
+};
+
+// -----------------------------------------------------------------------
+// network address
+// -----------------------------------------------------------------------
+
+class IPAddress {
+public:
+  IPAddress() : addr{0, 0, 0, 0} {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : addr{a, b, c, d} {}
+  uint8_t& operator [] (int index) { return addr[index]; }
+  String toString(void) const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", addr[0], addr[1], addr[2], addr[3]);
+    return buf;
+  }
+  bool fromString(const char* str) {
+    unsigned int a, b, c, d;
+    if (4 != sscanf(str, "%u.%u.%u.%u", &a, &b, &c, &d)) return false;
+    addr[0] = a; addr[1] = b; addr[2] = c; addr[3] = d;
+    return true;
+  }
+protected:
+  uint8_t addr[4];  //!< the address bytes
+};
+
+// -----------------------------------------------------------------------
+// ESP
+// -----------------------------------------------------------------------
+
+class EspClass {
+public:
+  uint64_t getEfuseMac(void) { return 0x0000563412CDAB00ULL; }
+  uint32_t getFreeHeap(void) { return 0; }
+  void restart(void) { exit(0); }
+};
+inline EspClass ESP;
+
+typedef void (*shutdown_handler_t)(void);
+typedef int esp_err_t;
+#define ESP_OK 0
+inline esp_err_t esp_register_shutdown_handler(shutdown_handler_t handler) { (void)handler; return ESP_OK; }
+
+// -----------------------------------------------------------------------
+// FreeRTOS, tasks are threads, a tick is a ms
+// -----------------------------------------------------------------------
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+#define pdTRUE                    1
+#define pdFALSE                   0
+#define pdPASS                    1
+#define portMAX_DELAY             0xFFFFFFFF
+#define pdMS_TO_TICKS(ms)         (ms)
+
+//! a task with its notification counter
+struct HostTask {
+  std::mutex mutex;                 //!< protects notify
+  std::condition_variable cv;       //!< signals notify
+  uint32_t notify = 0;              //!< the notification value
+};
+typedef HostTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+//! the task of the calling thread, created for threads not started with xTaskCreatePinnedToCore
+inline TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+  static thread_local TaskHandle_t task = new HostTask;
+  return task;
+}
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack,
+                                          void* param, UBaseType_t prio, TaskHandle_t* handle, BaseType_t core) {
+  (void)name; (void)stack; (void)prio; (void)core;
+  std::mutex mutex;
+  std::condition_variable cv;
+  TaskHandle_t task = NULL;
+  std::thread([&mutex, &cv, &task, fn, param]() {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      task = self;
+    }
+    cv.notify_one();
+    fn(param);
+  }).detach();
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [&]() { return NULL != task; });
+  if (handle) *handle = task;
+  return pdPASS;
+}
+inline void vTaskDelay(TickType_t ticks) {
+  delay(ticks);
+}
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  (void)task;
+  return 0;
+}
+inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lock(task->mutex);
+  auto ready = [task]() { return 0 < task->notify; };
+  if (portMAX_DELAY == ticks) {
+    task->cv.wait(lock, ready);
+  } else {
+    task->cv.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+  }
+  uint32_t value = task->notify;
+  if (value) task->notify = clear ? 0 : value - 1;
+  return value;
+}
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  {
+    std::lock_guard<std::mutex> lock(task->mutex);
+    task->notify ++;
+  }
+  task->cv.notify_all();
+  return pdPASS;
+}
+
+//! a counting semaphore, a mutex is a semaphore given once
+struct HostSemaphore {
+  std::mutex mutex;                 //!< protects count
+  std::condition_variable cv;       //!< signals count
+  UBaseType_t count;                //!< the count
+  UBaseType_t max;                  //!< the max count
+};
+typedef HostSemaphore* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+  return new HostSemaphore{ {}, {}, 1, 1 };
+}
+inline SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+  return new HostSemaphore{ {}, {}, 0, 1 };
+}
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(sem->mutex);
+  auto ready = [sem]() { return 0 < sem->count; };
+  if (portMAX_DELAY == ticks) {
+    sem->cv.wait(lock, ready);
+  } else if (!sem->cv.wait_for(lock, std::chrono::milliseconds(ticks), ready)) {
+    return pdFALSE;
+  }
+  sem->count --;
+  return pdTRUE;
+}
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+  {
+    std::lock_guard<std::mutex> lock(sem->mutex);
+    if (sem->count >= sem->max) return pdFALSE;
+    sem->count ++;
+  }
+  sem->cv.notify_one();
+  return pdTRUE;
+}
+
+// -----------------------------------------------------------------------
+// File system, the FFS and SD card are directories on the host
+// -----------------------------------------------------------------------
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+/** A file of the host file system, copies share the same FILE like on the ESP32
+ */
+class File : public Stream {
+public:
+  File() {}
+  File(FILE* fp, const char* path) : fp(fp, fclose), path(path) {}
+  size_t write(uint8_t ch) override { return write(&ch, 1); }
+  size_t write(const uint8_t* ptr, size_t size) override { return fp ? fwrite(ptr, 1, size, fp.get()) : 0; }
+  using Print::write;
+  int available(void) override { return fp ? (int)(size() - position()) : 0; }
+  int read(void) override { return fp ? fgetc(fp.get()) : -1; }
+  size_t read(uint8_t* ptr, size_t size) { return fp ? fread(ptr, 1, size, fp.get()) : 0; }
+  int peek(void) override {
+    int ch = read();
+    if (0 <= ch) ungetc(ch, fp.get());
+    return ch;
+  }
+  void flush(void) override { if (fp) fflush(fp.get()); }
+  size_t position(void) const { return fp ? ftell(fp.get()) : 0; }
+  size_t size(void) const {
+    if (!fp) return 0;
+    fflush(fp.get());
+    struct stat st;
+    return (0 == fstat(fileno(fp.get()), &st)) ? st.st_size : 0;
+  }
+  const char* name(void) const { return path.c_str(); }
+  void close(void) { fp.reset(); }
+  operator bool() const { return (bool)fp; }
+protected:
+  std::shared_ptr<FILE> fp;   //!< the file
+  std::string path;           //!< the path in the file system
+};
+
+/** A file system mounted on a host directory
+ */
+class FS {
+public:
+  FS(const char* root) : root(root), mounted(false) {}
+  void setRoot(const char* dir) { root = dir; }
+  bool begin(void) {
+    mounted = (0 == ::mkdir(root.c_str(), 0755)) || (EEXIST == errno);
+    return mounted;
+  }
+  void end(void) { mounted = false; }
+  bool format(void) { return false; }
+  File open(const char* path, const char* mode = FILE_READ) {
+    FILE* fp = mounted ? fopen(full(path).c_str(), (0 == strcmp(mode, FILE_READ)) ? "rb" : (0 == strcmp(mode, FILE_APPEND)) ? "ab" : "wb") : NULL;
+    return fp ? File(fp, path) : File();
+  }
+  File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+  bool exists(const char* path) { struct stat st; return mounted && (0 == stat(full(path).c_str(), &st)); }
+  bool exists(const String& path) { return exists(path.c_str()); }
+  bool remove(const char* path) { return mounted && (0 == ::remove(full(path).c_str())); }
+  bool remove(const String& path) { return remove(path.c_str()); }
+  bool rename(const char* from, const char* to) { return mounted && (0 == ::rename(full(from).c_str(), full(to).c_str())); }
+  bool mkdir(const char* path) { return mounted && (0 == ::mkdir(full(path).c_str(), 0755)); }
+protected:
+  std::string full(const char* path) { return root + path; }
+  std::string root;           //!< the host directory
+  bool mounted;               //!< begin was called
+};
+
+#endif // __HOST_ARDUINO_H__
@@ -0,0 +1,399 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_ARDUINOJSON_H__
+#define __HOST_ARDUINOJSON_H__
+
+/** Host replacement of the subset of ArduinoJson 7 used by CONFIG.h, the 
+ *  deserialization filter is accepted but not applied.
+ */
+
+#include <Arduino.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+const int JSON_MAX_DEPTH = 10; //!< nesting limit of the parser
+
+//! a value in the json tree
+struct JsonNode {
+  enum TYPE { NUL, BOOL, LONG, DOUBLE, STRING, ARRAY, OBJECT } type = NUL;
+  bool b = false;
+  long l = 0;
+  double d = 0.0;
+  std::string s;
+  std::vector<std::pair<std::string, std::unique_ptr<JsonNode>>> members; //!< objects, in insert order
+  std::vector<std::unique_ptr<JsonNode>> elements;                        //!< arrays
+
+  void clear(TYPE t) {
+    type = t;
+    s.clear();
+    members.clear();
+    elements.clear();
+  }
+  const JsonNode* find(const std::string& key) const {
+    if (OBJECT == type) {
+      for (auto& m : members) {
+        if (m.first == key) return m.second.get();
+      }
+    }
+    return NULL;
+  }
+  const JsonNode* at(size_t ix) const {
+    return ((ARRAY == type) && (ix < elements.size())) ? elements[ix].get() : NULL;
+  }
+  JsonNode* child(const std::string& key) {
+    if (OBJECT != type) clear(OBJECT);
+    for (auto& m : members) {
+      if (m.first == key) return m.second.get();
+    }
+    members.emplace_back(key, std::unique_ptr<JsonNode>(new JsonNode));
+    return members.back().second.get();
+  }
+  JsonNode* child(size_t ix) {
+    if (ARRAY != type) clear(ARRAY);
+    while (elements.size() <= ix) elements.emplace_back(new JsonNode);
+    return elements[ix].get();
+  }
+};
+
+//! read only reference to a value, the default is null
+class JsonVariantConst {
+public:
+  JsonVariantConst(const JsonNode* node = NULL) : node{node} {}
+  JsonVariantConst operator[](const char* key) const { return node ? node->find(key) : NULL; }
+  JsonVariantConst operator[](const String& key) const { return operator[](key.c_str()); }
+  JsonVariantConst operator[](int ix) const { return node ? node->at(ix) : NULL; }
+  bool isNull(void) const { return !node || (JsonNode::NUL == node->type); }
+  template <typename T> bool is(void) const {
+    if (!node) return false;
+    if (std::is_same<T, bool>::value) return JsonNode::BOOL == node->type;
+    if (std::is_same<T, const char*>::value || std::is_same<T, String>::value) return JsonNode::STRING == node->type;
+    if (std::is_integral<T>::value) return JsonNode::LONG == node->type;
+    if (std::is_floating_point<T>::value) return (JsonNode::LONG == node->type) || (JsonNode::DOUBLE == node->type);
+    return false;
+  }
+  template <typename T> T as(void) const { return convert((T*)NULL); }
+  operator const char*() const { return as<const char*>(); }
+  operator String() const { return as<String>(); }
+  operator bool() const { return as<bool>(); }
+  operator long() const { return as<long>(); }
+  operator double() const { return as<double>(); }
+protected:
+  const char* convert(const char**) const { return (node && (JsonNode::STRING == node->type)) ? node->s.c_str() : NULL; }
+  String convert(String*) const { const char* p = convert((const char**)NULL); return p ? p : ""; }
+  bool convert(bool*) const { return node && ((JsonNode::BOOL == node->type) ? node->b : (convert((long*)NULL) != 0)); }
+  long convert(long*) const {
+    if (!node) return 0;
+    return (JsonNode::LONG == node->type) ? node->l : (JsonNode::DOUBLE == node->type) ? (long)node->d : 0;
+  }
+  int convert(int*) const { return (int)convert((long*)NULL); }
+  double convert(double*) const {
+    if (!node) return 0.0;
+    return (JsonNode::DOUBLE == node->type) ? node->d : (JsonNode::LONG == node->type) ? node->l : 0.0;
+  }
+  const JsonNode* node; //!< the referenced value or NULL
+};
+
+//! writable reference to a member or element, created with its parents on the first assignment
+class JsonVariant {
+public:
+  JsonVariant(JsonNode* root) : root{root} {}
+  JsonVariant operator[](const char* key) const { JsonVariant v(*this); v.path.emplace_back(key, 0); return v; }
+  JsonVariant operator[](const String& key) const { return operator[](key.c_str()); }
+  JsonVariant operator[](int ix) const { JsonVariant v(*this); v.path.emplace_back(std::string(), ix + 1); return v; }
+  JsonVariant& operator=(bool value)           { JsonNode* n = create(JsonNode::BOOL);   n->b = value; return *this; }
+  JsonVariant& operator=(long value)           { JsonNode* n = create(JsonNode::LONG);   n->l = value; return *this; }
+  JsonVariant& operator=(int value)            { return operator=((long)value); }
+  JsonVariant& operator=(double value)         { JsonNode* n = create(JsonNode::DOUBLE); n->d = value; return *this; }
+  JsonVariant& operator=(const char* value)    { JsonNode* n = create(value ? JsonNode::STRING : JsonNode::NUL); if (value) n->s = value; return *this; }
+  JsonVariant& operator=(const String& value)  { return operator=(value.c_str()); }
+  operator JsonVariantConst() const { return find(); }
+  bool isNull(void) const { return find().isNull(); }
+  template <typename T> bool is(void) const { return find().is<T>(); }
+  template <typename T> T as(void) const { return find().as<T>(); }
+  operator const char*() const { return find(); }
+  operator String() const { return find(); }
+  operator bool() const { return find(); }
+  operator long() const { return find(); }
+  operator double() const { return find(); }
+protected:
+  JsonVariantConst find(void) const {
+    JsonVariantConst v(root);
+    for (auto& p : path) {
+      v = p.second ? v[p.second - 1] : v[p.first.c_str()];
+    }
+    return v;
+  }
+  JsonNode* create(JsonNode::TYPE type) const {
+    JsonNode* n = root;
+    for (auto& p : path) {
+      n = p.second ? n->child(p.second - 1) : n->child(p.first);
+    }
+    n->clear(type);
+    return n;
+  }
+  JsonNode* root;                                    //!< the document
+  std::vector<std::pair<std::string, int>> path;     //!< keys, or element index + 1
+};
+
+//! the document owns the tree
+class JsonDocument {
+public:
+  JsonVariant operator[](const char* key) { return JsonVariant(&root)[key]; }
+  JsonVariant operator[](const String& key) { return JsonVariant(&root)[key]; }
+  JsonVariant operator[](int ix) { return JsonVariant(&root)[ix]; }
+  JsonVariantConst operator[](const char* key) const { return JsonVariantConst(&root)[key]; }
+  bool isNull(void) const { return JsonNode::NUL == root.type; }
+  void clear(void) { root.clear(JsonNode::NUL); }
+  JsonNode root; //!< the top level value
+};
+
+class DeserializationError {
+public:
+  enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+  DeserializationError(Code code = Ok) : err{code} {}
+  friend bool operator==(const DeserializationError& a, const DeserializationError& b) { return a.err == b.err; }
+  friend bool operator!=(const DeserializationError& a, const DeserializationError& b) { return a.err != b.err; }
+  Code code(void) const { return err; }
+  const char* c_str(void) const {
+    static const char* txt[] = { "Ok", "EmptyInput", "IncompleteInput", "InvalidInput", "NoMemory", "TooDeep" };
+    return txt[err];
+  }
+protected:
+  Code err; //!< the error code
+};
+
+namespace DeserializationOption {
+  struct Filter {
+    Filter(JsonDocument&) {}
+  };
+}
+
+//! recursive descent parser over a buffer
+class JsonParser {
+public:
+  JsonParser(const char* buf, size_t size) : p{buf}, end{buf + size} {}
+  DeserializationError parse(JsonNode& node) {
+    skip();
+    if (p == end) return DeserializationError::EmptyInput;
+    return value(node, 0);
+  }
+protected:
+  void skip(void) {
+    while ((p < end) && isspace((unsigned char)*p)) p ++;
+  }
+  DeserializationError value(JsonNode& node, int depth) {
+    if (depth > JSON_MAX_DEPTH) return DeserializationError::TooDeep;
+    skip();
+    if (p == end) return DeserializationError::IncompleteInput;
+    if ('{' == *p) {
+      p ++;
+      node.clear(JsonNode::OBJECT);
+      skip();
+      if ((p < end) && ('}' == *p)) { p ++; return DeserializationError::Ok; }
+      for (;;) {
+        std::string key;
+        skip();
+        DeserializationError err = string(key);
+        if (DeserializationError::Ok != err) return err;
+        skip();
+        if (p == end) return DeserializationError::IncompleteInput;
+        if (':' != *p ++) return DeserializationError::InvalidInput;
+        err = value(*node.child(key), depth + 1);
+        if (DeserializationError::Ok != err) return err;
+        skip();
+        if (p == end) return DeserializationError::IncompleteInput;
+        char ch = *p ++;
+        if ('}' == ch) return DeserializationError::Ok;
+        if (',' != ch) return DeserializationError::InvalidInput;
+      }
+    } else if ('[' == *p) {
+      p ++;
+      node.clear(JsonNode::ARRAY);
+      skip();
+      if ((p < end) && (']' == *p)) { p ++; return DeserializationError::Ok; }
+      for (;;) {
+        DeserializationError err = value(*node.child(node.elements.size()), depth + 1);
+        if (DeserializationError::Ok != err) return err;
+        skip();
+        if (p == end) return DeserializationError::IncompleteInput;
+        char ch = *p ++;
+        if (']' == ch) return DeserializationError::Ok;
+        if (',' != ch) return DeserializationError::InvalidInput;
+      }
+    } else if ('"' == *p) {
+      node.clear(JsonNode::STRING);
+      return string(node.s);
+    } else if (literal("true")) {
+      node.clear(JsonNode::BOOL);
+      node.b = true;
+    } else if (literal("false")) {
+      node.clear(JsonNode::BOOL);
+    } else if (literal("null")) {
+      node.clear(JsonNode::NUL);
+    } else {
+      const char* start = p;
+      bool real = false;
+      while ((p < end) && (isdigit((unsigned char)*p) || strchr("+-.eE", *p))) {
+        real = real || (!isdigit((unsigned char)*p) && (('-' != *p) || (p != start)));
+        p ++;
+      }
+      if ((p == start) || (p - start > 32)) return DeserializationError::InvalidInput;
+      std::string num(start, p);
+      char* numEnd;
+      if (real) {
+        node.clear(JsonNode::DOUBLE);
+        node.d = strtod(num.c_str(), &numEnd);
+      } else {
+        node.clear(JsonNode::LONG);
+        node.l = strtol(num.c_str(), &numEnd, 10);
+      }
+      if (*numEnd) return DeserializationError::InvalidInput;
+    }
+    return DeserializationError::Ok;
+  }
+  bool literal(const char* txt) {
+    size_t len = strlen(txt);
+    if (((size_t)(end - p) < len) || (0 != strncmp(p, txt, len))) return false;
+    p += len;
+    return true;
+  }
+  DeserializationError string(std::string& str) {
+    if (p == end) return DeserializationError::IncompleteInput;
+    if ('"' != *p ++) return DeserializationError::InvalidInput;
+    while (p < end) {
+      char ch = *p ++;
+      if ('"' == ch) return DeserializationError::Ok;
+      if ('\\' == ch) {
+        if (p == end) break;
+        ch = *p ++;
+        switch (ch) {
+          case 'n': str += '\n'; break;
+          case 'r': str += '\r'; break;
+          case 't': str += '\t'; break;
+          case 'b': str += '\b'; break;
+          case 'f': str += '\f'; break;
+          case 'u': {
+              if (end - p < 4) return DeserializationError::IncompleteInput;
+              unsigned int cp = strtoul(std::string(p, 4).c_str(), NULL, 16);
+              p += 4;
+              if (cp < 0x80) {
+                str += (char)cp;
+              } else if (cp < 0x800) {
+                str += (char)(0xC0 | (cp >> 6));
+                str += (char)(0x80 | (cp & 0x3F));
+              } else {
+                str += (char)(0xE0 | (cp >> 12));
+                str += (char)(0x80 | ((cp >> 6) & 0x3F));
+                str += (char)(0x80 | (cp & 0x3F));
+              }
+            }
+            break;
+          default: str += ch; break;
+        }
+      } else {
+        str += ch;
+      }
+    }
+    return DeserializationError::IncompleteInput;
+  }
+  const char* p;   //!< read position
+  const char* end; //!< end of the input
+};
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const uint8_t* buf, size_t size) {
+  doc.clear();
+  JsonParser parser((const char*)buf, size);
+  DeserializationError err = parser.parse(doc.root);
+  if (DeserializationError::Ok != err) doc.clear();
+  return err;
+}
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* str) {
+  return deserializeJson(doc, (const uint8_t*)str, strlen(str));
+}
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* str, DeserializationOption::Filter) {
+  return deserializeJson(doc, str);
+}
+
+inline DeserializationError deserializeJson(JsonDocument& doc, File& file) {
+  std::vector<uint8_t> buf(file.available());
+  size_t len = buf.size() ? file.read(buf.data(), buf.size()) : 0;
+  return deserializeJson(doc, buf.data(), len);
+}
+
+//! append the json text of a value 
+inline void serializeJsonNode(const JsonNode& node, std::string& out) {
+  char num[32];
+  switch (node.type) {
+    case JsonNode::NUL:    out += "null"; break;
+    case JsonNode::BOOL:   out += node.b ? "true" : "false"; break;
+    case JsonNode::LONG:   snprintf(num, sizeof(num), "%ld", node.l); out += num; break;
+    case JsonNode::DOUBLE: snprintf(num, sizeof(num), "%.17g", node.d); out += num; break;
+    case JsonNode::STRING:
+      out += '"';
+      for (char ch : node.s) {
+        if      ('"'  == ch) out += "\\\"";
+        else if ('\\' == ch) out += "\\\\";
+        else if ('\n' == ch) out += "\\n";
+        else if ('\r' == ch) out += "\\r";
+        else if ('\t' == ch) out += "\\t";
+        else if ((unsigned char)ch < 0x20) { snprintf(num, sizeof(num), "\\u%04x", ch); out += num; }
+        else out += ch;
+      }
+      out += '"';
+      break;
+    case JsonNode::ARRAY:
+      out += '[';
+      for (size_t i = 0; i < node.elements.size(); i ++) {
+        if (i) out += ',';
+        serializeJsonNode(*node.elements[i], out);
+      }
+      out += ']';
+      break;
+    case JsonNode::OBJECT:
+      out += '{';
+      for (size_t i = 0; i < node.members.size(); i ++) {
+        JsonNode key;
+        key.type = JsonNode::STRING;
+        key.s = node.members[i].first;
+        if (i) out += ',';
+        serializeJsonNode(key, out);
+        out += ':';
+        serializeJsonNode(*node.members[i].second, out);
+      }
+      out += '}';
+      break;
+  }
+}
+
+inline size_t serializeJson(const JsonDocument& doc, String& str) {
+  std::string out;
+  serializeJsonNode(doc.root, out);
+  str = out.c_str();
+  return out.size();
+}
+
+inline size_t serializeJson(const JsonDocument& doc, File& file) {
+  std::string out;
+  serializeJsonNode(doc.root, out);
+  return file.write((const uint8_t*)out.data(), out.size());
+}
+
+#endif // __HOST_ARDUINOJSON_H__
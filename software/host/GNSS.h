@@ -0,0 +1,58 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __GNSS_H__
+#define __GNSS_H__
+
+/** Host stand-in of the GNSS receiver, it takes the place of ../GNSS.h (same guard) and only counts 
+ *  the correction data that LTE.h injects. 
+ */
+
+#include <atomic>
+#include "TIMELINE.h"
+
+class GNSS {
+
+public:
+  
+  typedef enum                          {  WLAN = 0, LTE,   LBAND,   KEYS,   WEBSOCKET,   BLUETOOTH,   NONE, NUM } SOURCE; //!< source enum for MSG 
+  const char* SOURCE_LUT[SOURCE::NUM] = { "WLAN",   "LTE", "LBAND", "KEYS", "WEBSOCKET", "BLUETOOTH", "-"        };  //!< source to text conversion
+
+  /** count the injected data
+   *  \param ptr  the data 
+   *  \param len  the size of the data
+   *  \param src  the source of the data
+   *  \return     the bytes taken 
+   */
+  size_t inject(const uint8_t* ptr, size_t len, SOURCE src) {
+    (void)ptr;
+    if (src < SOURCE::NUM) {
+      injected[src] += len;
+    }
+    if ((0 < len) && (src == LTE)) {
+      Timeline.mark(TIMELINE::CORRECTION);
+    }
+    log_d("%d bytes from %s source", (int)len, SOURCE_LUT[src]);
+    return len;
+  }
+
+  std::atomic<size_t> injected[SOURCE::NUM] = {}; //!< bytes injected per source
+};
+
+GNSS Gnss; //!< The global GNSS stand-in
+
+#endif // __GNSS_H__
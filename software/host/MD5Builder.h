@@ -0,0 +1,94 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_MD5BUILDER_H__
+#define __HOST_MD5BUILDER_H__
+
+/** Host replacement of the MD5 builder of the ESP32 Arduino core (RFC 1321)
+ */
+
+#include <Arduino.h>
+
+class MD5Builder {
+public:
+  void begin(void) {
+    state[0] = 0x67452301; state[1] = 0xefcdab89; state[2] = 0x98badcfe; state[3] = 0x10325476;
+    count = 0;
+  }
+  void add(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i ++) {
+      block[count ++ % 64] = data[i];
+      if (0 == (count % 64)) transform();
+    }
+  }
+  void add(const char* data) { add((const uint8_t*)data, strlen(data)); }
+  void add(const String& data) { add((const uint8_t*)data.c_str(), data.length()); }
+  void calculate(void) {
+    uint64_t bits = count * 8;
+    uint8_t pad = 0x80;
+    add(&pad, 1);
+    pad = 0;
+    while (56 != (count % 64)) add(&pad, 1);
+    for (int i = 0; i < 8; i ++) {
+      uint8_t b = bits >> (8 * i);
+      add(&b, 1);
+    }
+    for (int i = 0; i < 16; i ++) digest[i] = state[i / 4] >> (8 * (i % 4));
+  }
+  String toString(void) {
+    char str[33];
+    for (int i = 0; i < 16; i ++) snprintf(&str[2 * i], 3, "%02x", digest[i]);
+    return str;
+  }
+protected:
+  void transform(void) {
+    static const uint32_t K[64] = {
+      0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+      0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+      0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+      0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+      0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+      0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+      0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+      0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391 };
+    static const uint8_t R[16] = { 7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21 };
+    uint32_t m[16];
+    for (int i = 0; i < 16; i ++) {
+      m[i] = block[4 * i] | (block[4 * i + 1] << 8) | (block[4 * i + 2] << 16) | ((uint32_t)block[4 * i + 3] << 24);
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    for (int i = 0; i < 64; i ++) {
+      uint32_t f;
+      int g;
+      if (i < 16)      { f = (b & c) | (~b & d); g = i; }
+      else if (i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) % 16; }
+      else if (i < 48) { f = b ^ c ^ d;          g = (3 * i + 5) % 16; }
+      else             { f = c ^ (b | ~d);       g = (7 * i) % 16; }
+      f += a + K[i] + m[g];
+      int r = R[(i / 16) * 4 + (i % 4)];
+      a = d; d = c; c = b;
+      b += (f << r) | (f >> (32 - r));
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+  }
+  uint32_t state[4];    //!< the hash state
+  uint64_t count;       //!< the bytes added
+  uint8_t block[64];    //!< the current block
+  uint8_t digest[16];   //!< the result
+};
+
+#endif // __HOST_MD5BUILDER_H__
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_SD_H__
+#define __HOST_SD_H__
+
+/** Host replacement of the SD card, there is no card, so the AT and UBX log files are not written
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+
+typedef enum { CARD_NONE, CARD_MMC, CARD_SD, CARD_SDHC, CARD_UNKNOWN } sdcard_type_t;
+
+class SDFS : public FS {
+public:
+  SDFS() : FS("sd") {}
+  bool begin(uint8_t ssPin, SPIClass& spi, uint32_t frequency) { return false; }
+  sdcard_type_t cardType(void) { return CARD_NONE; }
+  uint64_t cardSize(void) { return 0; }
+  uint64_t usedBytes(void) { return 0; }
+  uint64_t totalBytes(void) { return 0; }
+};
+
+inline SDFS SD; //!< The SD card
+
+#endif // __HOST_SD_H__
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_SPI_H__
+#define __HOST_SPI_H__
+
+/** Host replacement of the SPI bus, only used by the SD card
+ */
+
+#include <Arduino.h>
+
+class SPIClass {
+public:
+  void end(void) {}
+};
+
+inline SPIClass SPI; //!< The SPI bus
+
+#endif // __HOST_SPI_H__
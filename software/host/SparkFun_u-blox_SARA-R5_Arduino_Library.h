@@ -0,0 +1,607 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_SARA_R5_H__
+#define __HOST_SARA_R5_H__
+
+/** Host replacement of the SparkFun SARA-R5 library for the subset used by LTE.h. The AT commands 
+ *  are the ones of the library and are sent over the HardwareSerial, so that LTE.h can run against 
+ *  tools/modemsim.py. URCs received while waiting for a response are queued and handled by poll(). 
+ */
+
+#include <Arduino.h>
+#include <deque>
+#include <vector>
+
+typedef enum {
+  SARA_R5_ERROR_INVALID = -1,
+  SARA_R5_ERROR_SUCCESS = 0,
+  SARA_R5_ERROR_OUT_OF_MEMORY,
+  SARA_R5_ERROR_TIMEOUT,
+  SARA_R5_ERROR_UNEXPECTED_PARAM,
+  SARA_R5_ERROR_UNEXPECTED_RESPONSE,
+  SARA_R5_ERROR_NO_RESPONSE,
+  SARA_R5_ERROR_DEREGISTERED,
+  SARA_R5_ERROR_ZERO_READ_LENGTH,
+  SARA_R5_ERROR_ERROR
+} SARA_R5_error_t;
+#define SARA_R5_SUCCESS SARA_R5_ERROR_SUCCESS
+
+typedef enum {
+  SARA_R5_REGISTRATION_INVALID = -1,
+  SARA_R5_REGISTRATION_NOT_REGISTERED = 0,
+  SARA_R5_REGISTRATION_HOME = 1,
+  SARA_R5_REGISTRATION_SEARCHING = 2,
+  SARA_R5_REGISTRATION_DENIED = 3,
+  SARA_R5_REGISTRATION_UNKNOWN = 4,
+  SARA_R5_REGISTRATION_ROAMING = 5
+} SARA_R5_registration_status_t;
+
+typedef enum { MNO_INVALID = -1, MNO_SW_DEFAULT = 0 } mobile_network_operator_t;
+typedef enum { PDP_TYPE_INVALID = -1, PDP_TYPE_IP = 0, PDP_TYPE_NONIP = 1, PDP_TYPE_IPV4V6 = 2, PDP_TYPE_IPV6 = 3 } SARA_R5_pdp_type;
+typedef enum { SARA_R5_TCP = 6, SARA_R5_UDP = 17 } SARA_R5_socket_protocol_t;
+typedef enum { SARA_R5_SEC_MANAGER_OPCODE_IMPORT = 0 } SARA_R5_sec_manager_opcode_t;
+typedef enum { SARA_R5_SEC_MANAGER_ROOTCA = 0, SARA_R5_SEC_MANAGER_CLIENT_CERT, SARA_R5_SEC_MANAGER_CLIENT_KEY, SARA_R5_SEC_MANAGER_SERVER_CERT } SARA_R5_sec_manager_parameter_t;
+typedef enum {
+  SARA_R5_SEC_PROFILE_PARAM_CERT_VAL_LEVEL = 0,
+  SARA_R5_SEC_PROFILE_PARAM_TLS_VER = 1,
+  SARA_R5_SEC_PROFILE_PARAM_CYPHER_SUITE = 2,
+  SARA_R5_SEC_PROFILE_PARAM_ROOT_CA = 3,
+  SARA_R5_SEC_PROFILE_PARAM_CLIENT_CERT = 5,
+  SARA_R5_SEC_PROFILE_PARAM_CLIENT_KEY = 6,
+  SARA_R5_SEC_PROFILE_PARAM_SNI = 10
+} SARA_R5_sec_profile_parameter_t;
+typedef enum { SARA_R5_SEC_PROFILE_CERTVAL_OPCODE_NO = 0, SARA_R5_SEC_PROFILE_CERTVAL_OPCODE_YESNOURL = 1 } SARA_R5_sec_profile_certval_op_code_t;
+typedef enum { SARA_R5_SEC_PROFILE_TLS_OPCODE_ANYVER = 0, SARA_R5_SEC_PROFILE_TLS_OPCODE_VER1_2 = 3 } SARA_R5_sec_profile_tls_op_code_t;
+typedef enum { SARA_R5_SEC_PROFILE_SUITE_OPCODE_PROPOSEDDEFAULT = 0 } SARA_R5_sec_profile_suite_op_code_t;
+typedef enum {
+  SARA_R5_MQTT_COMMAND_LOGOUT = 0,
+  SARA_R5_MQTT_COMMAND_LOGIN = 1,
+  SARA_R5_MQTT_COMMAND_PUBLISH = 2,
+  SARA_R5_MQTT_COMMAND_SUBSCRIBE = 4,
+  SARA_R5_MQTT_COMMAND_UNSUBSCRIBE = 5,
+  SARA_R5_MQTT_COMMAND_READ = 6
+} SARA_R5_mqtt_command_opcode_t;
+typedef enum { SARA_R5_MQTT_NV_RESTORE = 0 } SARA_R5_mqtt_nv_parameter_t;
+typedef enum { SARA_R5_HTTP_COMMAND_GET = 1, SARA_R5_HTTP_COMMAND_POST_FILE = 4 } SARA_R5_http_commands_t;
+typedef enum { SARA_R5_HTTP_CONTENT_APPLICATION_JSON = 4 } SARA_R5_http_content_types_t;
+typedef enum { SARA_R5_PSD_ACTION_RESET = 0, SARA_R5_PSD_ACTION_ACTIVATE = 3, SARA_R5_PSD_ACTION_DEACTIVATE = 4 } SARA_R5_pdp_actions_t;
+typedef enum { SARA_R5_PSD_CONFIG_PARAM_PROTOCOL = 0, SARA_R5_PSD_CONFIG_PARAM_MAP_TO_CID = 100 } SARA_R5_pdp_configuration_parameter_t;
+
+#define SARA_R5_NUM_PDP_CONTEXT_IDENTIFIERS 11
+
+const unsigned long SARA_R5_STANDARD_RESPONSE_TIMEOUT = 10000; //!< default response timeout
+const unsigned long SARA_R5_IP_CONNECT_TIMEOUT        = 130000; //!< socket connect timeout
+const unsigned long SARA_R5_INIT_TIMEOUT              =   1000; //!< timeout of the AT probes in begin()
+const size_t SARA_R5_CUSTOM_RESPONSE_SIZE             =    128; //!< size copied by sendCustomCommandWithResponse(), the smallest buffer LTE.h passes
+
+class SARA_R5 {
+public:
+  SARA_R5(int powerPin = -1, int resetPin = -1, uint8_t maxInitTries = 9) 
+      : _hardSerial{NULL}, _maxInitTries{maxInitTries}, _polling{false} {
+    (void)powerPin; (void)resetPin;
+  }
+  virtual ~SARA_R5() {}
+
+  /** open the serial port and probe the modem
+   *  \param hardSerial  the serial port
+   *  \param baud        the baudrate
+   *  \return            true if the modem responds
+   */
+  bool begin(HardwareSerial& hardSerial, unsigned long baud = 115200) {
+    _hardSerial = &hardSerial;
+    beginSerial(baud);
+    for (int i = 0; i < _maxInitTries; i ++) {
+      if (SARA_R5_SUCCESS == command("", NULL, SARA_R5_INIT_TIMEOUT)) {
+        command("E0");
+        command("+CMEE=2");
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** read and handle the URCs, the callbacks are called from here 
+   *  \return  true if a URC was handled
+   */
+  bool poll(void) {
+    if (_polling || !_hardSerial) {
+      return false;
+    }
+    _polling = true;
+    _cmd.clear();
+    int ch;
+    while (0 <= (ch = _hardSerial->read())) {
+      std::string line;
+      if (receive(ch, line) && isUrc(line)) {
+        _urcs.push_back(line);
+      }
+    }
+    bool handled = !_urcs.empty();
+    while (!_urcs.empty()) {
+      std::string line = _urcs.front();
+      _urcs.pop_front();
+      urc(line.c_str());
+    }
+    _polling = false;
+    return handled;
+  }
+
+  // -----------------------------------------------------------------------
+  // general
+  // -----------------------------------------------------------------------
+
+  SARA_R5_error_t at(void) { return command(""); }
+  SARA_R5_error_t setBaud(unsigned long baud) { return command("+IPR=" + String(baud)); }
+  String getManufacturerID(void) { return info("+CGMI"); }
+  String getModelID(void) { return info("+CGMM"); }
+  String getFirmwareVersion(void) { return info("+CGMR"); }
+  String getIMEI(void) { return info("+CGSN"); }
+  String getIMSI(void) { return info("+CIMI"); }
+  String getCCID(void) { return info("+CCID", "+CCID:"); }
+  String getSubscriberNo(void) { 
+    String resp;
+    command("+CNUM", &resp);
+    return resp;
+  }
+  String clock(void) { 
+    String time = info("+CCLK?", "+CCLK:");
+    time.replace("\"", "");
+    return time;
+  }
+  int rssi(void) {
+    int rssi = -1;
+    return (1 == scan("+CSQ", "+CSQ: %d", &rssi)) ? rssi : -1;
+  }
+  SARA_R5_error_t getSimStatus(String* code) {
+    String resp;
+    SARA_R5_error_t err = command("+CPIN?", &resp);
+    int pos = resp.indexOf("+CPIN: ");
+    if ((SARA_R5_SUCCESS == err) && (0 > pos)) {
+      err = SARA_R5_ERROR_UNEXPECTED_RESPONSE;
+    } else if ((SARA_R5_SUCCESS == err) && code) {
+      *code = resp.substring(pos + 7, resp.indexOf('\r', pos));
+    }
+    return err;
+  }
+  SARA_R5_error_t setSimPin(String pin) { return command("+CPIN=\"" + pin + "\""); }
+  bool setNetworkProfile(mobile_network_operator_t mno, bool autoReset = false, bool urcNotification = false) {
+    return SARA_R5_SUCCESS == command("+UMNOPROF=" + String((int)mno));
+  }
+  SARA_R5_error_t sendCustomCommandWithResponse(const char* cmd, const char* expectedResponse, char* responseDest, 
+                                               unsigned long timeout = SARA_R5_STANDARD_RESPONSE_TIMEOUT, bool at = true) {
+    String resp;
+    SARA_R5_error_t err = command(cmd, &resp, timeout, expectedResponse, 0, at);
+    if (responseDest) {
+      snprintf(responseDest, SARA_R5_CUSTOM_RESPONSE_SIZE, "%s", resp.c_str());
+    }
+    return err;
+  }
+
+  // -----------------------------------------------------------------------
+  // network registration and packet switched data
+  // -----------------------------------------------------------------------
+
+  SARA_R5_registration_status_t registration(bool eps = true) {
+    int n, stat;
+    if (2 != scan(eps ? "+CEREG?" : "+CREG?", eps ? "+CEREG: %d,%d" : "+CREG: %d,%d", &n, &stat)) {
+      return SARA_R5_REGISTRATION_INVALID;
+    }
+    return (SARA_R5_registration_status_t)stat;
+  }
+  SARA_R5_error_t setEpsRegistrationCallback(void (*callback)(SARA_R5_registration_status_t, unsigned int, unsigned int, int)) {
+    _epsRegistrationCallback = callback;
+    return command("+CEREG=2");
+  }
+  SARA_R5_error_t setRegistrationCallback(void (*callback)(SARA_R5_registration_status_t, unsigned int, unsigned int, int)) {
+    _registrationCallback = callback;
+    return command("+CREG=2");
+  }
+  SARA_R5_error_t getOperator(String* oper) {
+    String resp;
+    SARA_R5_error_t err = command("+COPS?", &resp);
+    int from = resp.indexOf('"');
+    int to = (0 <= from) ? resp.indexOf('"', from + 1) : -1;
+    if ((SARA_R5_SUCCESS == err) && (0 > to)) {
+      err = SARA_R5_ERROR_DEREGISTERED;
+    } else if (SARA_R5_SUCCESS == err) {
+      *oper = resp.substring(from + 1, to);
+    }
+    return err;
+  }
+  SARA_R5_error_t setAPN(String apn, uint8_t cid = 1, SARA_R5_pdp_type pdpType = PDP_TYPE_IP) {
+    const char* TYPE_LUT[] = { "IP", "NONIP", "IPV4V6", "IPV6" };
+    const char* type = ((PDP_TYPE_IP <= pdpType) && (PDP_TYPE_IPV6 >= pdpType)) ? TYPE_LUT[pdpType] : "IP";
+    return command("+CGDCONT=" + String((int)cid) + ",\"" + type + "\",\"" + apn + "\"");
+  }
+  SARA_R5_error_t getAPN(int cid, String* apn, IPAddress* ip, SARA_R5_pdp_type* pdpType = NULL) {
+    String resp;
+    SARA_R5_error_t err = command("+CGDCONT?", &resp);
+    // +CGDCONT: <cid>,"<type>","<apn>","<ip>",...
+    for (int pos = resp.indexOf("+CGDCONT: "); (SARA_R5_SUCCESS == err) && (0 <= pos); pos = resp.indexOf("+CGDCONT: ", pos + 1)) {
+      int id;
+      char type[16];
+      char name[64] = "";
+      char addr[40] = "";
+      if ((2 <= sscanf(resp.c_str() + pos, "+CGDCONT: %d,\"%15[^\"]\",\"%63[^\"]\",\"%39[^\"]\"", &id, type, name, addr)) && (id == cid)) {
+        *apn = name;
+        ip->fromString(addr);
+        if (pdpType) {
+          *pdpType = !strcmp(type, "IP") ? PDP_TYPE_IP : !strcmp(type, "NONIP") ? PDP_TYPE_NONIP : 
+                     !strcmp(type, "IPV4V6") ? PDP_TYPE_IPV4V6 : !strcmp(type, "IPV6") ? PDP_TYPE_IPV6 : PDP_TYPE_INVALID;
+        }
+      }
+    }
+    return err;
+  }
+  SARA_R5_error_t activatePDPcontext(bool status, int cid = -1) {
+    return command("+CGACT=" + String(status ? 1 : 0) + ((0 <= cid) ? "," + String(cid) : String()));
+  }
+  SARA_R5_error_t setPDPconfiguration(int profile, SARA_R5_pdp_configuration_parameter_t param, int value) {
+    return command("+UPSD=" + String(profile) + "," + String((int)param) + "," + String(value));
+  }
+  SARA_R5_error_t performPDPaction(int profile, SARA_R5_pdp_actions_t action) {
+    return command("+UPSDA=" + String(profile) + "," + String((int)action));
+  }
+  void setPSDActionCallback(void (*callback)(int, IPAddress)) { _psdActionRequestCallback = callback; }
+
+  // -----------------------------------------------------------------------
+  // security
+  // -----------------------------------------------------------------------
+
+  SARA_R5_error_t resetSecurityProfile(int profile) { return command("+USECPRF=" + String(profile)); }
+  SARA_R5_error_t configSecurityProfile(int profile, SARA_R5_sec_profile_parameter_t param, int value) {
+    return command("+USECPRF=" + String(profile) + "," + String((int)param) + "," + String(value));
+  }
+  SARA_R5_error_t configSecurityProfileString(int profile, SARA_R5_sec_profile_parameter_t param, String value) {
+    return command("+USECPRF=" + String(profile) + "," + String((int)param) + ",\"" + value + "\"");
+  }
+  SARA_R5_error_t setSecurityManager(SARA_R5_sec_manager_opcode_t opcode, SARA_R5_sec_manager_parameter_t param, String name, String data) {
+    return upload("+USECMNG=" + String((int)opcode) + "," + String((int)param) + ",\"" + name + "\"," + String(data.length()), 
+                  '>', data.c_str(), data.length());
+  }
+
+  // -----------------------------------------------------------------------
+  // files and HTTP
+  // -----------------------------------------------------------------------
+
+  SARA_R5_error_t deleteFile(String name) { return command("+UDELFILE=\"" + name + "\""); }
+  SARA_R5_error_t appendFileContents(String name, String data) { return appendFileContents(name, data.c_str(), data.length()); }
+  SARA_R5_error_t appendFileContents(String name, const char* data, int len) {
+    return upload("+UDWNFILE=\"" + name + "\"," + String(len), '>', data, len);
+  }
+  SARA_R5_error_t getFileContents(String name, String* contents) {
+    SARA_R5_error_t err = command("+URDFILE=\"" + name + "\"");
+    if (SARA_R5_SUCCESS == err) {
+      *contents = _binary;
+    }
+    return err;
+  }
+  SARA_R5_error_t resetHTTPprofile(int profile) { return command("+UHTTP=" + String(profile)); }
+  SARA_R5_error_t setHTTPserverName(int profile, String server) { return command("+UHTTP=" + String(profile) + ",1,\"" + server + "\""); }
+  SARA_R5_error_t setHTTPserverPort(int profile, int port) { return command("+UHTTP=" + String(profile) + ",5," + String(port)); }
+  SARA_R5_error_t setHTTPauthentication(int profile, bool authenticate) { return command("+UHTTP=" + String(profile) + ",4," + String(authenticate ? 1 : 0)); }
+  SARA_R5_error_t setHTTPsecure(int profile, bool secure, int secprofile = -1) {
+    return command("+UHTTP=" + String(profile) + ",6," + String(secure ? 1 : 0) + ((0 <= secprofile) ? "," + String(secprofile) : String()));
+  }
+  SARA_R5_error_t sendHTTPGET(int profile, String path, String responseFilename) {
+    return command("+UHTTPC=" + String(profile) + "," + String((int)SARA_R5_HTTP_COMMAND_GET) + ",\"" + path + "\",\"" + responseFilename + "\"");
+  }
+  SARA_R5_error_t sendHTTPPOSTfile(int profile, String path, String responseFilename, String requestFile, SARA_R5_http_content_types_t httpContentType) {
+    return command("+UHTTPC=" + String(profile) + "," + String((int)SARA_R5_HTTP_COMMAND_POST_FILE) + ",\"" + path + "\",\"" + 
+                   responseFilename + "\",\"" + requestFile + "\"," + String((int)httpContentType));
+  }
+  SARA_R5_error_t getHTTPprotocolError(int profile, int* error_class, int* error_code) {
+    int p;
+    return (3 == scan(("+UHTTPER=" + String(profile)).c_str(), "+UHTTPER: %d,%d,%d", &p, error_class, error_code)) ? 
+            SARA_R5_SUCCESS : SARA_R5_ERROR_UNEXPECTED_RESPONSE;
+  }
+  void setHTTPCommandCallback(void (*callback)(int, int, int)) { _httpCommandRequestCallback = callback; }
+
+  // -----------------------------------------------------------------------
+  // MQTT
+  // -----------------------------------------------------------------------
+
+  SARA_R5_error_t nvMQTT(SARA_R5_mqtt_nv_parameter_t param) { return command("+UMQTTNV=" + String((int)param)); }
+  SARA_R5_error_t setMQTTclientId(const String& clientId) { return command("+UMQTT=0,\"" + clientId + "\""); }
+  SARA_R5_error_t setMQTTserver(const String& serverName, int port) { return command("+UMQTT=2,\"" + serverName + "\"," + String(port)); }
+  SARA_R5_error_t setMQTTsecure(bool secure, int secprofile = -1) {
+    return command("+UMQTT=11," + String(secure ? 1 : 0) + ((0 <= secprofile) ? "," + String(secprofile) : String()));
+  }
+  SARA_R5_error_t connectMQTT(void) { return command("+UMQTTC=1"); }
+  SARA_R5_error_t disconnectMQTT(void) { return command("+UMQTTC=0"); }
+  SARA_R5_error_t subscribeMQTTtopic(int maxQoS, const String& topic) { return command("+UMQTTC=4," + String(maxQoS) + ",\"" + topic + "\""); }
+  SARA_R5_error_t unsubscribeMQTTtopic(const String& topic) { return command("+UMQTTC=5,\"" + topic + "\""); }
+  SARA_R5_error_t readMQTT(int* pQos, String* pTopic, uint8_t* readDest, int readLength, int* bytesRead) {
+    String resp;
+    SARA_R5_error_t err = command("+UMQTTC=6,1", &resp);
+    if (SARA_R5_SUCCESS == err) {
+      // +UMQTTC: 6,<qos>,<total>,<topic_len>,"<topic>",<msg_len>,"<msg>"
+      int pos = resp.indexOf("+UMQTTC: 6,");
+      int total, topicLen;
+      char topic[128] = "";
+      if ((0 > pos) || (4 > sscanf(resp.c_str() + pos, "+UMQTTC: 6,%d,%d,%d,\"%127[^\"]\"", pQos, &total, &topicLen, topic))) {
+        return SARA_R5_ERROR_UNEXPECTED_RESPONSE;
+      }
+      *pTopic = topic;
+      int len = ((int)_binary.size() < readLength) ? (int)_binary.size() : readLength;
+      memcpy(readDest, _binary.data(), len);
+      *bytesRead = len;
+    }
+    return err;
+  }
+  SARA_R5_error_t getMQTTprotocolError(int* error_code, int* error_code2) {
+    return (2 == scan("+UMQTTER", "+UMQTTER: %d,%d", error_code, error_code2)) ? SARA_R5_SUCCESS : SARA_R5_ERROR_UNEXPECTED_RESPONSE;
+  }
+  void setMQTTCommandCallback(void (*callback)(int, int)) { _mqttCommandRequestCallback = callback; }
+
+  // -----------------------------------------------------------------------
+  // sockets
+  // -----------------------------------------------------------------------
+
+  int socketOpen(SARA_R5_socket_protocol_t protocol, unsigned int localPort = 0) {
+    int socket = -1;
+    String cmd = "+USOCR=" + String((int)protocol) + (localPort ? "," + String(localPort) : String());
+    return (1 == scan(cmd.c_str(), "+USOCR: %d", &socket)) ? socket : -1;
+  }
+  SARA_R5_error_t socketClose(int socket) { return command("+USOCL=" + String(socket)); }
+  SARA_R5_error_t socketSetSecure(int socket, bool secure, int secprofile = -1) {
+    return command("+USOSEC=" + String(socket) + "," + String(secure ? 1 : 0) + ((0 <= secprofile) ? "," + String(secprofile) : String()));
+  }
+  SARA_R5_error_t socketConnect(int socket, const char* address, unsigned int port) {
+    return command("+USOCO=" + String(socket) + ",\"" + address + "\"," + String(port), NULL, SARA_R5_IP_CONNECT_TIMEOUT);
+  }
+  SARA_R5_error_t socketWrite(int socket, const char* str, int len = -1) {
+    len = (0 > len) ? strlen(str) : len;
+    return upload("+USOWR=" + String(socket) + "," + String(len), '@', str, len);
+  }
+  SARA_R5_error_t socketWrite(int socket, String str) { return socketWrite(socket, str.c_str(), str.length()); }
+  SARA_R5_error_t socketReadAvailable(int socket, int* length) {
+    int s;
+    return (2 == scan(("+USORD=" + String(socket) + ",0").c_str(), "+USORD: %d,%d", &s, length)) ? SARA_R5_SUCCESS : SARA_R5_ERROR_UNEXPECTED_RESPONSE;
+  }
+  SARA_R5_error_t socketRead(int socket, int length, char* readDest, int* bytesRead = NULL) {
+    SARA_R5_error_t err = command("+USORD=" + String(socket) + "," + String(length));
+    if (SARA_R5_SUCCESS == err) {
+      int len = ((int)_binary.size() < length) ? (int)_binary.size() : length;
+      memcpy(readDest, _binary.data(), len);
+      if (bytesRead) {
+        *bytesRead = len;
+      }
+    }
+    return err;
+  }
+  int socketGetLastError(void) {
+    int err = -1;
+    return (1 == scan("+USOER", "+USOER: %d", &err)) ? err : -1;
+  }
+  SARA_R5_error_t socketDirectLinkTimeTrigger(int socket, unsigned long timerTrigger) {
+    return command("+UDCONF=5," + String(socket) + "," + String(timerTrigger));
+  }
+  SARA_R5_error_t socketDirectLinkMode(int socket) { return command("+USODL=" + String(socket), NULL, SARA_R5_STANDARD_RESPONSE_TIMEOUT, "CONNECT"); }
+  void setSocketReadCallbackPlus(void (*callback)(int, const char*, int, IPAddress, int)) { _socketReadCallbackPlus = callback; }
+
+protected:
+
+  /** open the serial port, LTE.h overrides this to keep the flow control 
+   *  \param baud  the baudrate
+   */
+  virtual void beginSerial(unsigned long baud) {
+    _hardSerial->begin(baud);
+  }
+
+  /** send a command and wait for the final result
+   *  \param cmd       the command without the AT
+   *  \param resp      optional, the information text lines
+   *  \param timeout   the response timeout
+   *  \param expect    the final result, default "OK"
+   *  \param prompt    if not 0 return when this prompt is received 
+   *  \param at        prefix the command with AT
+   *  \return          the result
+   */
+  SARA_R5_error_t command(const String& cmd, String* resp = NULL, unsigned long timeout = SARA_R5_STANDARD_RESPONSE_TIMEOUT, 
+                          const char* expect = NULL, char prompt = 0, bool at = true) {
+    if (!_hardSerial) {
+      return SARA_R5_ERROR_INVALID;
+    }
+    _cmd = cmd.c_str();
+    _binary.clear();
+    String text = (at ? "AT" : "") + cmd + "\r";
+    _hardSerial->write((const uint8_t*)text.c_str(), text.length());
+    int32_t end = millis() + timeout;
+    while (0 < (end - (int32_t)millis())) {
+      int ch = _hardSerial->read();
+      if (0 > ch) {
+        delay(1);
+      } else if (prompt && (ch == prompt) && _line.empty()) {
+        return SARA_R5_SUCCESS;
+      } else {
+        std::string line;
+        if (receive(ch, line)) {
+          if (isUrc(line)) {
+            _urcs.push_back(line);
+          } else if (line == (expect ? expect : "OK")) {
+            return SARA_R5_SUCCESS;
+          } else if ((line == "ERROR") || (0 == line.rfind("+CME ERROR", 0)) || (0 == line.rfind("+CMS ERROR", 0))) {
+            return SARA_R5_ERROR_ERROR;
+          } else if (resp) {
+            *resp += line.c_str();
+            *resp += "\r\n";
+          }
+        }
+      }
+    }
+    return SARA_R5_ERROR_NO_RESPONSE;
+  }
+
+  /** send a command, wait for the prompt and send the data
+   *  \param cmd     the command without the AT
+   *  \param prompt  the prompt
+   *  \param data    the data
+   *  \param len     the size of data
+   *  \return        the result
+   */
+  SARA_R5_error_t upload(const String& cmd, char prompt, const char* data, int len) {
+    SARA_R5_error_t err = command(cmd, NULL, SARA_R5_STANDARD_RESPONSE_TIMEOUT, NULL, prompt);
+    if (SARA_R5_SUCCESS == err) {
+      _hardSerial->write((const uint8_t*)data, len);
+      err = command("", NULL, SARA_R5_STANDARD_RESPONSE_TIMEOUT, NULL, 0, false);
+    }
+    return err;
+  }
+
+  /** collect a character, the payload of binary responses is read into _binary
+   *  \param ch    the character
+   *  \param line  set to the line when complete
+   *  \return      true if a line is complete
+   */
+  bool receive(int ch, std::string& line) {
+    if (('\r' == ch) || ('\n' == ch)) {
+      if (_line.empty()) {
+        return false;
+      }
+      line.swap(_line);
+      _line.clear();
+      return true;
+    }
+    _line += (char)ch;
+    int len = ('"' == ch) ? binaryLength() : -1;
+    int32_t end = millis() + SARA_R5_STANDARD_RESPONSE_TIMEOUT;
+    while ((0 < len) && (0 < (end - (int32_t)millis()))) {
+      ch = _hardSerial->read();
+      if (0 > ch) {
+        delay(1);
+      } else {
+        _binary += (char)ch;
+        len --;
+      }
+    }
+    return false;
+  }
+
+  /** check if the line is the start of a binary payload, the opening quote follows the 
+   *  comma after the length field
+   *  \return  the payload length or -1
+   */
+  int binaryLength(void) {
+    static const struct { const char* prefix; int commas; } BINARY_LUT[] = {
+      { "+URDFILE:",   2 }, // +URDFILE: "<name>",<len>,"<data>"
+      { "+USORD:",     2 }, // +USORD: <socket>,<len>,"<data>"
+      { "+UMQTTC: 6,", 6 }, // +UMQTTC: 6,<qos>,<total>,<topic_len>,"<topic>",<len>,"<data>"
+    };
+    size_t size = _line.size();
+    if ((3 > size) || (',' != _line[size - 2])) {
+      return -1;
+    }
+    for (auto& bin : BINARY_LUT) {
+      if ((0 == _line.rfind(bin.prefix, 0)) && (bin.commas == std::count(_line.begin(), _line.end(), ','))) {
+        size_t pos = _line.rfind(',', size - 3);
+        pos = (std::string::npos == pos) ? _line.find(' ') : pos;
+        return atoi(_line.c_str() + pos + 1);
+      }
+    }
+    return -1;
+  }
+
+  /** check if a line is a URC, registration URCs are only URCs if not the response to the query
+   *  \param line  the line
+   *  \return      true for a URC
+   */
+  bool isUrc(const std::string& line) {
+    return (0 == line.rfind("+UU", 0)) || 
+           ((0 == line.rfind("+CEREG:", 0)) && (0 != _cmd.rfind("+CEREG", 0))) ||
+           ((0 == line.rfind("+CREG:", 0))  && (0 != _cmd.rfind("+CREG", 0)));
+  }
+
+  /** handle a URC and call the callback
+   *  \param line  the URC
+   */
+  void urc(const char* line) {
+    int a, b, c, d;
+    char str[40] = "";
+    if (1 <= sscanf(line, "+CEREG: %d,%x,%x,%d", &a, &b, &c, &d)) {
+      if (_epsRegistrationCallback) _epsRegistrationCallback((SARA_R5_registration_status_t)a, 0, 0, 0);
+    } else if (1 <= sscanf(line, "+CREG: %d,%x,%x,%d", &a, &b, &c, &d)) {
+      if (_registrationCallback) _registrationCallback((SARA_R5_registration_status_t)a, 0, 0, 0);
+    } else if (2 == sscanf(line, "+UUMQTTC: %d,%d", &a, &b)) {
+      if (_mqttCommandRequestCallback) _mqttCommandRequestCallback(a, b);
+    } else if (3 == sscanf(line, "+UUHTTPCR: %d,%d,%d", &a, &b, &c)) {
+      if (_httpCommandRequestCallback) _httpCommandRequestCallback(a, b, c);
+    } else if (1 <= sscanf(line, "+UUPSDA: %d,\"%39[^\"]\"", &a, str)) {
+      IPAddress ip;
+      ip.fromString(str);
+      if (_psdActionRequestCallback) _psdActionRequestCallback(a, ip);
+    } else if (2 == sscanf(line, "+UUSORD: %d,%d", &a, &b)) {
+      if (_socketReadCallbackPlus && (0 < b)) {
+        std::vector<char> buf(b);
+        int read = 0;
+        if (SARA_R5_SUCCESS == socketRead(a, b, buf.data(), &read)) {
+          _socketReadCallbackPlus(a, buf.data(), read, IPAddress(), 0);
+        }
+      }
+    }
+  }
+
+  /** send a command and scan the response 
+   *  \param cmd     the command without the AT
+   *  \param format  the sscanf format of the response line 
+   *  \return        the number of scanned fields, 0 on error
+   */
+  template <typename... ARGS> int scan(const char* cmd, const char* format, ARGS... args) {
+    String resp;
+    if (SARA_R5_SUCCESS != command(cmd, &resp)) {
+      return 0;
+    }
+    const char* prefix = strchr(format, ' ');
+    int pos = resp.indexOf(String(format).substring(0, prefix ? prefix - format : 0));
+    return (0 <= pos) ? sscanf(resp.c_str() + pos, format, args...) : 0;
+  }
+
+  /** send a command and get the information text
+   *  \param cmd     the command without the AT
+   *  \param prefix  optional, the prefix to remove
+   *  \return        the text of the first line
+   */
+  String info(const char* cmd, const char* prefix = NULL) {
+    String resp;
+    command(cmd, &resp);
+    int pos = prefix ? resp.indexOf(prefix) : 0;
+    if (0 > pos) {
+      return String();
+    }
+    pos += prefix ? strlen(prefix) : 0;
+    String text = resp.substring(pos, resp.indexOf('\r', pos));
+    text.trim();
+    return text;
+  }
+
+  HardwareSerial* _hardSerial;     //!< the serial port of the modem
+  uint8_t _maxInitTries;           //!< AT probes in begin()
+  std::string _cmd;                //!< the pending command
+  std::string _line;               //!< the line being received
+  std::string _binary;             //!< the payload of the last binary response
+  std::deque<std::string> _urcs;   //!< URCs received while waiting for a response
+  bool _polling;                   //!< poll() is running, the callbacks may send commands
+  void (*_epsRegistrationCallback)(SARA_R5_registration_status_t, unsigned int, unsigned int, int) = NULL;
+  void (*_registrationCallback)(SARA_R5_registration_status_t, unsigned int, unsigned int, int) = NULL;
+  void (*_psdActionRequestCallback)(int, IPAddress) = NULL;
+  void (*_httpCommandRequestCallback)(int, int, int) = NULL;
+  void (*_mqttCommandRequestCallback)(int, int) = NULL;
+  void (*_socketReadCallbackPlus)(int, const char*, int, IPAddress, int) = NULL;
+};
+
+#endif // __HOST_SARA_R5_H__
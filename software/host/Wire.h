@@ -0,0 +1,38 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_WIRE_H__
+#define __HOST_WIRE_H__
+
+/** Host replacement of the I2C bus, there is no GNSS receiver on the host
+ */
+
+#include <Arduino.h>
+
+class TwoWire : public Stream {
+public:
+  TwoWire(uint8_t bus_num) : _bus_num(bus_num) {}
+  size_t write(uint8_t ch) override { return 1; }
+  size_t write(const uint8_t* ptr, size_t size) override { return size; }
+  using Print::write;
+  int available(void) override { return 0; }
+  int read(void) override { return -1; }
+protected:
+  uint8_t _bus_num; //!< the bus number
+};
+
+#endif // __HOST_WIRE_H__
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_BASE64_H__
+#define __HOST_BASE64_H__
+
+/** Host replacement of the base64 helper of the ESP32 Arduino core
+ */
+
+#include <Arduino.h>
+#include <mbedtls/base64.h>
+
+class base64 {
+public:
+  static String encode(const String& text) {
+    size_t len = 0;
+    mbedtls_base64_encode(NULL, 0, &len, (const unsigned char*)text.c_str(), text.length());
+    std::vector<unsigned char> buf(len);
+    if (0 != mbedtls_base64_encode(buf.data(), len, &len, (const unsigned char*)text.c_str(), text.length())) {
+      return String();
+    }
+    return String((const char*)buf.data());
+  }
+};
+
+#endif // __HOST_BASE64_H__
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_CBUF_H__
+#define __HOST_CBUF_H__
+
+/** Host replacement of the circular buffer of the ESP32 Arduino core
+ */
+
+#include <Arduino.h>
+
+class cbuf {
+public:
+  cbuf(size_t size) : buf(size + 1), rd(0), wr(0) {}
+  size_t size(void) { return buf.size() - 1; }
+  size_t available(void) { return (wr + buf.size() - rd) % buf.size(); }
+  size_t room(void) { return size() - available(); }
+  bool empty(void) { return rd == wr; }
+  void flush(void) { rd = wr = 0; }
+  size_t write(char ch) { return write(&ch, 1); }
+  size_t write(const char* ptr, size_t len) {
+    size_t n = 0;
+    while ((n < len) && room()) {
+      buf[wr] = ptr[n ++];
+      wr = (wr + 1) % buf.size();
+    }
+    return n;
+  }
+  size_t read(char* ptr, size_t len) {
+    size_t n = 0;
+    while ((n < len) && !empty()) {
+      ptr[n ++] = buf[rd];
+      rd = (rd + 1) % buf.size();
+    }
+    return n;
+  }
+protected:
+  std::vector<char> buf;  //!< the storage, one byte is kept free
+  size_t rd;              //!< the read position
+  size_t wr;              //!< the write position
+};
+
+#endif // __HOST_CBUF_H__
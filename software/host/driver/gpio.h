@@ -0,0 +1,33 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_DRIVER_GPIO_H__
+#define __HOST_DRIVER_GPIO_H__
+
+/** Host replacement of the ESP-IDF GPIO driver
+ */
+
+#include <Arduino.h>
+
+typedef int gpio_num_t;
+
+inline esp_err_t gpio_set_level(gpio_num_t pin, uint32_t level) {
+  digitalWrite(pin, level);
+  return ESP_OK;
+}
+
+#endif // __HOST_DRIVER_GPIO_H__
@@ -0,0 +1,26 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_DRIVER_UART_H__
+#define __HOST_DRIVER_UART_H__
+
+/** Host replacement of the ESP-IDF UART driver
+ */
+
+typedef enum { UART_NUM_0 = 0, UART_NUM_1, UART_NUM_2 } uart_port_t;
+
+#endif // __HOST_DRIVER_UART_H__
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+/** Host build of LTE.h, the LTE state machine runs against tools/modemsim.py on a pseudo terminal 
+ *  instead of the modem. The corrections are counted by the GNSS stand-in.  
+ *
+ *    make -C host
+ *    python3 tools/modemsim.py --client "host/ltehost {}" --duration 120 --json bench.json
+ *
+ *    ltehost <port> [--duration s] [--ztp token] [--ntrip url] [--ffs dir]
+ */
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "HW.h"
+#include "TIMELINE.h"
+#include "CONFIG.h"
+#include "UBXFILE.h"
+#include "GNSS.h" // the stand-in in this folder, it takes the guard of ../GNSS.h
+#include "LTE.h"
+
+int main(int argc, char* argv[]) {
+  const char* port = NULL;
+  const char* ztp = "host-token";
+  const char* ntrip = NULL;
+  const char* ffs = "ffs";
+  long duration = 60;
+  for (int i = 1; i < argc; i ++) {
+    if (!strcmp(argv[i], "--duration") && (i + 1 < argc)) {
+      duration = atol(argv[++ i]);
+    } else if (!strcmp(argv[i], "--ztp") && (i + 1 < argc)) {
+      ztp = argv[++ i];
+    } else if (!strcmp(argv[i], "--ntrip") && (i + 1 < argc)) {
+      ntrip = argv[++ i];
+    } else if (!strcmp(argv[i], "--ffs") && (i + 1 < argc)) {
+      ffs = argv[++ i];
+    } else if ('-' != argv[i][0]) {
+      port = argv[i];
+    } else {
+      port = NULL;
+      break;
+    }
+  }
+  if (!port) {
+    fprintf(stderr, "usage: %s <port> [--duration s] [--ztp token] [--ntrip url] [--ffs dir]\n", argv[0]);
+    return 1;
+  }
+  HardwareSerial::setPort(port);
+  SPIFFS.setRoot(ffs);
+  // the modem is on and the UART is idle 
+  digitalWrite(LTE_ON, LTE_ON_ACTIVE);
+  digitalWrite(LTE_RXO, HIGH);
+  digitalWrite(LTE_CTS, LOW);
+  
+  Config.init();
+  if (ntrip) {
+    Config.setValue(CONFIG::KEY_USESOURCE, "NTRIP: LTE");
+    Config.setValue(CONFIG::KEY_NTRIP_SERVER, ntrip);
+    Config.setValue(CONFIG::KEY_NTRIP_VERSION, NTRIP_VERSION_1); // modemsim.py replies "ICY 200 OK"
+  } else {
+    Config.setValue(CONFIG::KEY_USESOURCE, "PointPerfect: LTE");
+    Config.setValue(CONFIG::KEY_ZTPTOKEN, ztp);
+  }
+  Lte.init();
+  
+  delay(duration * 1000);
+  Timeline.dump();
+  String stats = UbxSerial.atStats();
+  fprintf(stderr, "%s", stats.c_str());
+  fprintf(stderr, "injected %zu bytes\n", (size_t)Gnss.injected[GNSS::LTE]);
+  fflush(stderr);
+  _exit(0); // the tasks run forever
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2022 by Michael Ammann (@mazgch)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+
+#ifndef __HOST_MBEDTLS_BASE64_H__
+#define __HOST_MBEDTLS_BASE64_H__
+
+/** Host replacement of the mbedtls base64 functions, same return values
+ */
+
+#include <cstddef>
+#include <cstring>
+
+#define MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL  -0x002A  //!< output buffer too small
+#define MBEDTLS_ERR_BASE64_INVALID_CHARACTER -0x002C  //!< invalid character in input
+
+//! the base64 alphabet
+static const char MBEDTLS_BASE64_LUT[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/** encode a buffer, call with dst NULL to get the required size in olen
+ *  \return  0 on success 
+ */
+inline int mbedtls_base64_encode(unsigned char* dst, size_t dlen, size_t* olen, const unsigned char* src, size_t slen) {
+  size_t len = 4 * ((slen + 2) / 3) + 1; // including the zero termination
+  if ((NULL == dst) || (dlen < len)) {
+    *olen = len;
+    return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+  }
+  unsigned char* p = dst;
+  for (size_t i = 0; i < slen; i += 3) {
+    unsigned int v = src[i] << 16 | ((i + 1 < slen) ? src[i + 1] << 8 : 0) | ((i + 2 < slen) ? src[i + 2] : 0);
+    *p++ = MBEDTLS_BASE64_LUT[(v >> 18) & 0x3F];
+    *p++ = MBEDTLS_BASE64_LUT[(v >> 12) & 0x3F];
+    *p++ = (i + 1 < slen) ? MBEDTLS_BASE64_LUT[(v >> 6) & 0x3F] : '=';
+    *p++ = (i + 2 < slen) ? MBEDTLS_BASE64_LUT[v & 0x3F] : '=';
+  }
+  *p = '\0';
+  *olen = p - dst;
+  return 0;
+}
+
+/** decode a buffer, call with dst NULL to get the required size in olen
+ *  \return  0 on success 
+ */
+inline int mbedtls_base64_decode(unsigned char* dst, size_t dlen, size_t* olen, const unsigned char* src, size_t slen) {
+  size_t n = 0;
+  unsigned int v = 0;
+  int bits = 0;
+  size_t len = 0;
+  for (size_t i = 0; i < slen; i ++) {
+    if ((src[i] == '=') || (src[i] == '\r') || (src[i] == '\n')) continue;
+    const char* p = strchr(MBEDTLS_BASE64_LUT, src[i]);
+    if ((NULL == p) || ('\0' == src[i])) return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    v = (v << 6) | (p - MBEDTLS_BASE64_LUT);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      len ++;
+    }
+  }
+  if ((NULL == dst) || (dlen < len)) {
+    *olen = len;
+    return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+  }
+  bits = 0;
+  for (size_t i = 0; i < slen; i ++) {
+    if ((src[i] == '=') || (src[i] == '\r') || (src[i] == '\n')) continue;
+    v = (v << 6) | (strchr(MBEDTLS_BASE64_LUT, src[i]) - MBEDTLS_BASE64_LUT);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      dst[n ++] = (v >> bits) & 0xFF;
+    }
+  }
+  *olen = n;
+  return 0;
+}
+
+#endif // __HOST_MBEDTLS_BASE64_H__
@@ -70,6 +70,7 @@
 //-------------------------------------------------------------------------------------
 #include "LOG.h"          // Comment this if you do not want a separate log level for this application 
 #include "HW.h"
+#include "TIMELINE.h"
 #include "CONFIG.h"
 #include "UBXFILE.h"
 //#include "BLUETOOTH.h"  // Optional, Comment this to save memory if not needed, choose the flash size 4MB and suitable partition
@@ -83,13 +84,15 @@
 // MAIN setup / loop
 // ====================================================================================
 
+const int SERIAL_TIMEOUT = 500; //!< Wait at most this long (ms since reset) for the Serial port 
+
 /** Main Arduino setup function, initilizes all functions which spins off various tasks
 */
 void setup(void) {
   // initialisation --------------------------------
   // serial port
   Serial.begin(115200);
-  while (!Serial);
+  while (!Serial && (SERIAL_TIMEOUT > millis()))
     /*nothing*/;
   log_i("-------------------------------------------------------------------");
   Config.init();
@@ -116,14 +119,8 @@ void setup(void) {
   // i2c wire
   UbxWire.begin(I2C_SDA, I2C_SCL); // Start I2C
   UbxWire.setClock(400000); //Increase I2C clock speed to 400kHz
-  if (!Gnss.detect()) { 
-    log_w("GNSS ZED-F9 not detected, check wiring");
-  }
-#ifdef __LBAND_H__
-  if (!LBand.detect()) {
-    log_w("LBAND NEO-D9 not detected, check wiring");
-  }
-#endif  
+  // the GNSS and LBAND receivers are detected by their poll function called from loop, 
+  // this way setup does not block and they come up while WLAN and LTE connect in their tasks
 #ifdef __CANBUS_H__
   Canbus.init();
 #endif
@@ -139,6 +136,7 @@ void loop(void) {
   delay(50);
 
   memUsage();
+  UbxSerial.atStatsPoll();
 }
 
 // ====================================================================================
@@ -179,9 +177,9 @@ void memUsage(void) {
   // this code allows to print all the stacks of the different tasks
   if (MEM_USAGE_INTERVAL && (0 >= (lastMs - now))) {
     lastMs = now + MEM_USAGE_INTERVAL;
-    char buf[128];
+    char buf[192];
     int len = 0;
-    const char* tasks[] = { pcTaskGetName(NULL), "Lte", "Wlan", "Bluetooth", "UbxSd", "Led", "Can" };
+    const char* tasks[] = { pcTaskGetName(NULL), "Config", "Lte", "Wlan", "Websocket", "Bluetooth", "UbxSd", "Led", "Can" };
     for (int i = 0; i < sizeof(tasks)/sizeof(*tasks); i ++) {
       const char *name = tasks[i];
       TaskHandle_t h = 0;
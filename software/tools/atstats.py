@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 by Michael Ammann (@mazgch)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Rebuild the AT command latency statistics from a LTE AT command logfile
+# recorded with UBXSERIAL_TIMESTAMP (uncomment it in UBXFILE.h), the output
+# matches the "atstats" websocket command:
+#
+#   python3 tools/atstats.py HPG-0001.TXT
+#
+
+import re
+import sys
+
+BINS = 16      # same as UBXSERIAL_ATSTATS_BINS
+LINE = 24      # same as UBXSERIAL_ATSTATS_LINE
+NAME = 16      # size of the name buffers on the device
+
+# URCs reporting the result of a command, +UUxxx completes AT+Uxxx
+COMPLETE = ['+UUMQTTC', '+UUHTTPCR', '+UUPSDA', '+UUSOCO']
+
+STAMP = re.compile(rb'^\[(-?\d+)\] ?(.*)$')
+URC = re.compile(r'^\+[A-Z+]+$')
+
+class Stat:
+    def __init__(self, name):
+        self.name = name
+        self.count = 0
+        self.timed = 0
+        self.sum = 0
+        self.max = 0
+        self.last = 0
+        self.hist = [0] * BINS
+
+    def add(self, ms):
+        self.count += 1
+        if ms is not None and ms >= 0:
+            b = 0
+            while b < BINS - 1 and ms >= (1 << b):
+                b += 1
+            self.hist[b] += 1
+            self.timed += 1
+            self.sum += ms
+            self.max = max(self.max, ms)
+
+    def text(self):
+        if not self.timed:
+            return '%s n %u' % (self.name, self.count)
+        limit = (self.timed * 95 + 99) // 100
+        total = 0
+        b = 0
+        while b < BINS - 1:
+            total += self.hist[b]
+            if total >= limit:
+                break
+            b += 1
+        p95 = (1 << b) if b < BINS - 1 else self.max
+        return '%s n %u mean %u p95 <%u max %u ms' % (self.name, self.count,
+                self.sum // self.timed, min(p95, self.max), self.max)
+
+def main(path):
+    stats = {}
+    def find(name, add=True):
+        if name not in stats and add:
+            stats[name] = Stat(name)
+        return stats.get(name)
+    pending = None
+    ttag = 0
+    with open(path, 'rb') as f:
+        data = f.read()
+    for raw in re.split(rb'[\r\n]+', data):
+        m = STAMP.match(raw)
+        if not m:
+            continue
+        now = int(m.group(1))
+        line = m.group(2)[:LINE - 1].decode('ascii', 'replace')
+        if not line:
+            continue
+        # the modem echo is off, so lines starting with AT were sent by the device
+        if line.startswith('AT'):
+            pending = re.split(r'[=?]', line, 1)[0][:NAME - 1]
+            ttag = now
+            find(pending).last = now
+        elif pending and (line == 'OK' or line.startswith('ERROR') or
+                          line.startswith('+CME ERROR') or line.startswith('+CMS ERROR')):
+            find(pending).add(now - ttag)
+            pending = None
+        elif line.startswith('+UU') or (line.startswith('+') and not pending):
+            name = line.split(':', 1)[0]
+            if len(name) >= NAME or not URC.match(name):
+                continue  # binary data that happens to start with a '+'
+            ms = None
+            if name in COMPLETE:
+                cmd = find('AT+' + name[2:], False)
+                ms = (now - cmd.last) if cmd else None
+            find(name).add(ms)
+    for stat in stats.values():
+        print(stat.text())
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        sys.exit('usage: %s <logfile>' % sys.argv[0])
+    main(sys.argv[1])
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 by Michael Ammann (@mazgch)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Scripted run of the LTE NTRIP direct link mode (LTE_NTRIP_DIRECTLINK) against
+# tools/modemsim.py. It issues the same AT sequence as LTE::ntripConnect() and
+# LTE::ntripDirectStart(), reads the stream like LTE::ntripDirectRead() with
+# reads split at random positions, leaves the mode with LTE::ntripDirectExit()
+# and enters it again until the simulated network drop ends it with DISCONNECT.
+# The run fails if the payload differs from what the modem streamed, e.g. if
+# the bytes of DISCONNECT were passed on to the GNSS.
+#
+#   python3 tools/directlink.py [--seed 1] [--runs 3]
+#
+
+import argparse
+import os
+import random
+import re
+import select
+import sys
+import threading
+import time
+import tty
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import modemsim
+
+GUARD = 0.2  # LTE_DIRECTLINK_GUARD, the simulator does not check it
+
+class DirectReader:
+    """ port of LTE::ntripDirectRead() """
+    DISCONNECT = b'\r\nDISCONNECT\r\n'
+
+    def __init__(self):
+        self.match = 0
+        self.payload = b''
+        self.closed = False
+
+    def read(self, data):
+        # the bytes that matched the start of DISCONNECT were held back by the last read
+        buf = self.DISCONNECT[:self.match]
+        end = -1
+        used = 0
+        for ch in data:
+            used += 1
+            buf += bytes([ch])
+            self.match = self.match + 1 if ch == self.DISCONNECT[self.match] else \
+                         1 if ch == self.DISCONNECT[0] else 0
+            if self.match == len(self.DISCONNECT):
+                self.closed = True
+                self.match = 0
+                end = len(buf) - len(self.DISCONNECT)
+                break
+        self.payload += buf[:end if end >= 0 else len(buf) - self.match]
+        return used
+
+class Client:
+    """ the host side of the pty, like the UbxSerial of the ESP32 """
+
+    def __init__(self, name):
+        self.fd = os.open(name, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        self.rx = b''
+
+    def write(self, data):
+        os.write(self.fd, data.encode() if isinstance(data, str) else data)
+
+    def fill(self, timeout):
+        if select.select([self.fd], [], [], timeout)[0]:
+            self.rx += os.read(self.fd, 4096)
+
+    def expect(self, pattern, timeout=5.0):
+        end = time.monotonic() + timeout
+        while True:
+            m = re.search(pattern, self.rx)
+            if m:
+                self.rx = self.rx[m.end():]
+                return m
+            if time.monotonic() > end:
+                raise TimeoutError('%r not received, got %r' % (pattern, self.rx[-80:]))
+            self.fill(0.05)
+
+    def at(self, cmd, final=rb'\r\nOK\r\n', timeout=5.0):
+        self.write(cmd + '\r')
+        return self.expect(final, timeout)
+
+def session(client, duration):
+    """ enter direct link mode and read the stream, returns the reader """
+    client.at('AT+USODL=0', rb'\r\nCONNECT\r\n')
+    reader = DirectReader()
+    end = time.monotonic() + duration
+    while not reader.closed and time.monotonic() < end:
+        client.fill(0.05)
+        while client.rx and not reader.closed:
+            # like the loop task, only a part of the received data is read per call
+            n = random.randint(1, 32)
+            used = reader.read(client.rx[:n])
+            client.rx = client.rx[used:]
+        client.write('$GPGGA,sim*00\r\n')  # sent by the time trigger of the modem
+    return reader
+
+def test(run, seed):
+    args, io, modem = modemsim.setup(['--register', '50', '--period', '100', '--size', '200',
+                                      '--drop', '4', '--drops', '1', '--outage', '60000',
+                                      '--seed', str(seed + run)])
+    stop = threading.Event()
+    thread = threading.Thread(target=modemsim.run, args=(modem, io), kwargs={'stop': stop}, daemon=True)
+    thread.start()
+    client = Client(io.name)
+    try:
+        client.expect(rb'\+CEREG: 5')
+        client.at('AT+UPSDA=0,3')
+        client.expect(rb'\+UUPSDA: 0')
+        client.at('AT+USOCR=6')
+        client.at('AT+USOCO=0,"caster",2101')
+        request = b'GET /TEST HTTP/1.0\r\n\r\n'
+        client.at('AT+USOWR=0,%d' % len(request), rb'@')
+        client.write(request)
+        client.expect(rb'\+USOWR: 0,\d+\r\nOK\r\n')
+        client.expect(rb'\+UUSORD: 0,\d+')
+        client.at('AT+USORD=0,1024', rb'ICY 200 OK\r\n\r\n"\r\n\r\nOK\r\n')
+        # first session, left by the escape sequence
+        reader = session(client, 0.5)
+        time.sleep(GUARD)
+        client.write('+++')
+        time.sleep(GUARD)
+        client.expect(rb'\r\nOK\r\n')
+        client.at('AT')
+        escaped = not reader.closed
+        # second session, ended by the network drop
+        reader = session(client, 10)
+        good = escaped and reader.closed and (reader.payload == modem.directSent) and \
+               (b'DISCONNECT' not in reader.payload)
+        modemsim.log('direct link run %d: escape %s, %d of %d bytes until DISCONNECT %s' % (run,
+                     'ok' if escaped else 'FAILED', len(reader.payload), len(modem.directSent),
+                     'ok' if good else 'FAILED'))
+        return good
+    except TimeoutError as err:
+        modemsim.log('direct link run %d: FAILED, %s' % (run, err))
+        return False
+    finally:
+        os.close(client.fd)
+        stop.set()
+        thread.join()
+
+def main():
+    parser = argparse.ArgumentParser(description='scripted run of the LTE direct link mode against modemsim.py')
+    parser.add_argument('--runs', type=int, default=3, help='number of runs')
+    parser.add_argument('--seed', type=int, help='seed of the read splits and data')
+    args = parser.parse_args()
+    seed = random.randrange(1 << 16) if args.seed is None else args.seed
+    ok = all([test(run, seed) for run in range(args.runs)])
+    sys.exit(0 if ok else 1)
+
+if __name__ == '__main__':
+    main()
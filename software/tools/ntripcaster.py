@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 by Michael Ammann (@mazgch)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Stand-in NTRIP caster for testing the WLAN and LTE NTRIP clients on a local
+# network. It answers NTRIP v1 requests with "ICY 200 OK" and NTRIP v2
+# requests ("Ntrip-Version: Ntrip/2.0") with chunked transfer encoding, then
+# streams random correction data. GGA sentences sent by the client are logged.
+#
+#   python3 tools/ntripcaster.py --port 2101 --period 1000 --size 500
+#   python3 tools/ntripcaster.py --end 10      # end the stream after 10 messages
+#   python3 tools/ntripcaster.py --selftest    # decode test of ICY and chunked replies
+#
+# The self test streams through a local socket and decodes the replies with
+# the same state machine as WLAN::ntripParseLine() and WLAN::ntripDechunk(),
+# the reads are split at random positions to cover all state transitions.
+#
+
+import argparse
+import random
+import socket
+import sys
+import threading
+import time
+
+def log(text):
+    sys.stderr.write('%8.3f %s\n' % (time.monotonic(), text))
+
+def chunk(data):
+    return b'%X\r\n' % len(data) + data + b'\r\n'
+
+class Caster:
+
+    def __init__(self, args):
+        self.args = args
+        self.sent = []
+
+    def handle(self, conn, addr):
+        request = b''
+        while b'\r\n\r\n' not in request:
+            data = conn.recv(1024)
+            if not data:
+                return
+            request += data
+        head, rest = request.split(b'\r\n\r\n', 1)
+        lines = head.decode('latin-1').split('\r\n')
+        log('%s:%d %s' % (addr[0], addr[1], lines[0]))
+        v2 = any(l.lower().startswith('ntrip-version:') and '2.0' in l for l in lines[1:])
+        if v2:
+            conn.sendall(b'HTTP/1.1 200 OK\r\nNtrip-Version: Ntrip/2.0\r\nContent-Type: gnss/data\r\n'
+                         b'Transfer-Encoding: chunked\r\n\r\n')
+        else:
+            conn.sendall(b'ICY 200 OK\r\n')
+        conn.settimeout(self.args.period / 1000.0)
+        count = 0
+        while not self.args.end or count < self.args.end:
+            data = bytes(random.getrandbits(8) for _ in range(self.args.size))
+            self.sent.append(data)
+            count += 1
+            last = self.args.end and count >= self.args.end
+            if v2:
+                # the last chunk shares the write with the payload to check it is not dropped
+                pieces = []
+                pos = 0
+                while pos < len(data):
+                    n = random.randint(1, self.args.chunk)
+                    pieces.append(chunk(data[pos:pos + n]))
+                    pos += n
+                conn.sendall(b''.join(pieces) + (b'0\r\n\r\n' if last else b''))
+            else:
+                conn.sendall(data)
+            try:
+                gga = conn.recv(1024)
+                if gga:
+                    log('gga %s' % gga.strip().decode('latin-1'))
+                elif gga == b'':
+                    break
+            except socket.timeout:
+                pass
+        conn.close()
+        log('%s:%d closed after %d messages' % (addr[0], addr[1], count))
+
+    def serve(self, sock):
+        while True:
+            conn, addr = sock.accept()
+            threading.Thread(target=self.handle, args=(conn, addr), daemon=True).start()
+
+class Decoder:
+    """ port of WLAN::ntripParseLine() and WLAN::ntripDechunk() """
+    CHUNK_SIZE = -1
+    CHUNK_CRLF = -2
+
+    def __init__(self):
+        self.header = True
+        self.first = True
+        self.chunked = False
+        self.left = self.CHUNK_SIZE
+        self.line = ''
+        self.payload = b''
+        self.end = False
+
+    def feed(self, buf):
+        i = 0
+        while self.header and i < len(buf):
+            ch = chr(buf[i])
+            i += 1
+            if ch == '\n':
+                self.parse(self.line)
+                self.line = ''
+            elif ch != '\r':
+                self.line += ch
+        if not self.header and not self.end:
+            buf = buf[i:]
+            self.payload += self.dechunk(buf) if self.chunked else buf
+
+    def parse(self, line):
+        if self.first:
+            self.first = False
+            if line == 'ICY 200 OK':
+                self.header = False
+            elif not (line.startswith('HTTP/') and ' 200 ' in line):
+                raise ValueError('response "%s"' % line)
+        elif not line:
+            self.header = False
+        elif line.lower().startswith('transfer-encoding:') and 'chunked' in line.lower():
+            self.chunked = True
+
+    def dechunk(self, buf):
+        out = b''
+        i = 0
+        while i < len(buf):
+            if self.left == self.CHUNK_SIZE:
+                ch = chr(buf[i])
+                i += 1
+                if ch == '\n':
+                    self.left = int(self.line.split(';')[0] or '0', 16)
+                    self.line = ''
+                    if self.left == 0:
+                        self.end = True
+                        break
+                elif ch != '\r' and len(self.line) < 16:
+                    self.line += ch
+            elif self.left == self.CHUNK_CRLF:
+                if buf[i] == ord('\n'):
+                    self.left = self.CHUNK_SIZE
+                i += 1
+            else:
+                n = min(len(buf) - i, self.left)
+                out += buf[i:i + n]
+                i += n
+                self.left -= n
+                if self.left == 0:
+                    self.left = self.CHUNK_CRLF
+        return out
+
+def selftest(args):
+    ok = True
+    for version in ('1.0', '2.0'):
+        for run in range(args.runs):
+            caster = Caster(args)
+            sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+            sock.bind(('127.0.0.1', 0))
+            sock.listen(1)
+            threading.Thread(target=caster.serve, args=(sock,), daemon=True).start()
+            client = socket.create_connection(sock.getsockname())
+            request = 'GET /TEST HTTP/1.1\r\nHost: localhost\r\n'
+            if version == '2.0':
+                request += 'Ntrip-Version: Ntrip/2.0\r\n'
+            client.sendall((request + '\r\n').encode())
+            stream = b''
+            while True:
+                data = client.recv(4096)
+                if not data:
+                    break
+                stream += data
+            client.close()
+            sock.close()
+            # feed the decoder with reads of random size
+            decoder = Decoder()
+            pos = 0
+            while pos < len(stream) and not decoder.end:
+                n = random.randint(1, 64)
+                decoder.feed(stream[pos:pos + n])
+                pos += n
+            expect = b''.join(caster.sent)
+            good = (decoder.payload == expect) and (decoder.end == (version == '2.0'))
+            ok = ok and good
+            log('ntrip %s run %d: %d of %d bytes %s' % (version, run, len(decoder.payload), len(expect),
+                'ok' if good else 'FAILED'))
+    return ok
+
+def main():
+    parser = argparse.ArgumentParser(description='stand-in NTRIP caster for the HPG NTRIP clients')
+    parser.add_argument('--host', default='0.0.0.0', help='address to listen on')
+    parser.add_argument('--port', type=int, default=2101, help='port to listen on')
+    parser.add_argument('--period', type=int, default=1000, help='correction message period in ms')
+    parser.add_argument('--size', type=int, default=500, help='correction message size')
+    parser.add_argument('--chunk', type=int, default=200, help='max chunk size for NTRIP v2')
+    parser.add_argument('--end', type=int, default=0, help='end the stream after this many messages, 0 never ends')
+    parser.add_argument('--seed', type=int, help='seed of the random data and chunk sizes')
+    parser.add_argument('--selftest', action='store_true', help='decode ICY and chunked replies locally and exit')
+    parser.add_argument('--runs', type=int, default=5, help='runs per NTRIP version of the self test')
+    args = parser.parse_args()
+    random.seed(args.seed)
+    if args.selftest:
+        args.period = 1
+        args.end = args.end or 20
+        sys.exit(0 if selftest(args) else 1)
+    sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind((args.host, args.port))
+    sock.listen(4)
+    log('listening on %s:%d' % (args.host, args.port))
+    try:
+        Caster(args).serve(sock)
+    except KeyboardInterrupt:
+        pass
+
+if __name__ == '__main__':
+    main()
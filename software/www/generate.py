@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+#
+# Copyright 2022 by Michael Ammann (@mazgch)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Compress the static monitor assets of this folder into ../WEBSOCKET_WWW.h
+# Run this script whenever one of the files changes and commit the result:
+#
+#   python3 www/generate.py
+#
+
+import gzip
+import hashlib
+import os
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+OUTPUT = os.path.join(HERE, '..', 'WEBSOCKET_WWW.h')
+
+# name of the C array, file and mime type
+ASSETS = [
+    ('HTML', 'monitor.html', 'text/html'),
+    ('CSS',  'monitor.css',  'text/css'),
+    ('JS',   'monitor.js',   'text/javascript'),
+]
+
+def array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append('  ' + ''.join('0x%02X,' % b for b in data[i:i + 16]))
+    return '\n'.join(lines)
+
+def main():
+    out = []
+    out.append('// Generated by www/generate.py from the files in the www folder, do not edit.')
+    out.append('')
+    out.append('#ifndef __WEBSOCKET_WWW_H__')
+    out.append('#define __WEBSOCKET_WWW_H__')
+    for name, file, mime in ASSETS:
+        with open(os.path.join(HERE, file), 'rb') as f:
+            raw = f.read()
+        # mtime 0 keeps the output reproducible, so the ETag only changes with the content
+        data = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = hashlib.sha256(raw).hexdigest()[:16]
+        out.append('')
+        out.append('//! %s, %d bytes, %d bytes compressed' % (file, len(raw), len(data)))
+        out.append('#define WEBSOCKET_WWW_%s_MIME "%s"' % (name, mime))
+        out.append('#define WEBSOCKET_WWW_%s_ETAG "\\"%s\\""' % (name, etag))
+        out.append('const uint8_t WEBSOCKET_WWW_%s[] PROGMEM = {' % name)
+        out.append(array(data))
+        out.append('};')
+    out.append('')
+    out.append('#endif // __WEBSOCKET_WWW_H__')
+    with open(OUTPUT, 'w', newline='\n') as f:
+        f.write('\n'.join(out) + '\n')
+    print('wrote %s' % os.path.normpath(OUTPUT))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,144 @@
+  "use strict";
+  let map = null; 
+  let track = null;
+  let point = null;
+  let connected = false
+  let ws = null
+  let output = null
+  
+  function log(message, color = 'black') {
+    if (null != output) {
+      const el = document.createElement('div')
+      el.innerHTML = message
+      el.style.color = color
+      output.append(el)
+      output.scrollTop = output.scrollHeight
+    }
+  }
+
+  // decode the binary WEBSOCKET::TELEMETRY message
+  const TELEMETRY_MAGIC = 'HPGT'
+  const TELEMETRY_VERSION = 1
+  const TELEMETRY_SIZE = 50
+  const SOURCE = [ 'WLAN', 'LTE', 'LBAND', 'KEYS', 'WEBSOCKET', 'BLUETOOTH', '-' ]
+  const FIX = [ 'No', 'DR', '2D', '3D', '3D+DR', 'TM', '', '' ]
+  const CARR = [ 'No', 'Float', 'Fixed', '' ]
+  // the lastCorrectionAge range code of UBX-NAV-PVT, upper bound in seconds, null if not available
+  const CORR_AGE = [ null, 1, 2, 5, 10, 15, 20, 30, 45, 60, 90, 120, Infinity ]
+  function telemetry(data) {
+    if (data.byteLength < TELEMETRY_SIZE) return null
+    const dv = new DataView(data)
+    const magic = String.fromCharCode(dv.getUint8(0), dv.getUint8(1), dv.getUint8(2), dv.getUint8(3))
+    if ((magic != TELEMETRY_MAGIC) || (dv.getUint8(4) != TELEMETRY_VERSION)) return null
+    const pad = (v) => String(v).padStart(2, '0')
+    const flags = dv.getUint8(8)
+    return {
+      source:   SOURCE[dv.getUint8(5)] || '-',
+      fix:      FIX[dv.getUint8(6) & 7],
+      carr:     CARR[dv.getUint8(7) & 3],
+      fixOk:    0 != (flags & 1),
+      numSV:    dv.getUint8(9),
+      corrAge:  CORR_AGE[dv.getUint8(10)] ?? null,
+      date:     `${dv.getUint16(12, true)}-${pad(dv.getUint8(11))}-${pad(dv.getUint8(14))}`,
+      time:     `${pad(dv.getUint8(15))}:${pad(dv.getUint8(16))}:${pad(dv.getUint8(17))}`,
+      iTOW:     dv.getUint32(18, true),
+      lat:      dv.getInt32(22, true) * 1e-7 + dv.getInt8(38) * 1e-9,
+      lon:      dv.getInt32(26, true) * 1e-7 + dv.getInt8(39) * 1e-9,
+      height:   dv.getInt32(30, true) * 1e-3 + dv.getInt8(40) * 1e-4,
+      hMSL:     dv.getInt32(34, true) * 1e-3 + dv.getInt8(41) * 1e-4,
+      hAcc:     dv.getUint32(42, true) * 1e-3,
+      vAcc:     dv.getUint32(46, true) * 1e-3,
+    }
+  }
+
+  window.onload = function _onload() {
+    // create the map
+    let el = document.getElementById('map');
+    if (ol !== undefined) {
+      el.removeAttribute('hidden');
+      const pos = ol.proj.fromLonLat([8.565783, 47.284641])
+      track = new ol.Feature( { geometry: new ol.geom.LineString([]) } )
+      track.setStyle( new ol.style.Style({
+          stroke: new ol.style.Stroke({
+            color: 'rgba(255,110,89,0.7)', 
+            width: 3,
+            lineCap: 'round'
+          })
+        }) 
+      )
+      let svg = '<svg xmlns="http://www.w3.org/2000/svg" width="24" height="24" viewBox="0 0 24 24" fill="none" stroke="white" stroke-width="3" stroke-linecap="round" stroke-linejoin="round"><circle cx="12" cy="12" r="10"></circle><line x1="22" y1="12" x2="18" y2="12"></line><line x1="6" y1="12" x2="2" y2="12"></line><line x1="12" y1="6" x2="12" y2="2"></line><line x1="12" y1="22" x2="12" y2="18"></line></svg>';
+      let icon = new ol.style.Icon({ color:'#ff6e59', opacity: 1, src: 'data:image/svg+xml;utf8,' + svg,
+                   anchor: [0.5, 0.5], anchorXUnits: 'fraction', anchorYUnits: 'fraction', });
+      point = new ol.Feature( { geometry: new ol.geom.Point(pos) } )
+      point.setStyle( new ol.style.Style( { image: icon } ) );
+      map = new ol.Map({
+        target: 'map',
+        controls: ol.control.defaults().extend([ new ol.control.ScaleLine({ units: 'metric' }) ]),
+        layers: [
+          new ol.layer.Tile({
+            source: new ol.source.OSM()
+          }), 
+          new ol.layer.Vector({
+            source: new ol.source.Vector({
+              features: [point, track]
+            }),
+          })
+        ],
+        view: new ol.View({
+          center: ol.proj.fromLonLat(pos),
+          zoom: 16
+        })
+      });
+    } 
+
+    const message = document.querySelector('#message')
+    output = document.querySelector('#output')
+    const url = ((window.location.protocol == 'https:') ? 'wss:' : 'ws:') + '//' + window.location.host + ':8080'
+    ws = new WebSocket(url)
+    ws.binaryType = 'arraybuffer'
+    
+    ws.addEventListener('open', () => {
+      connected = true
+      log('Open', 'green')
+      // this page only shows the telemetry, no need for the raw data
+      ws.send('unsubscribe all')
+      ws.send('subscribe telemetry')
+    })
+    ws.addEventListener('close', () => {
+      connected = false
+      log('Close', 'red')
+    })
+    ws.addEventListener('message', ({ data }) => {
+      if (data instanceof ArrayBuffer) {
+        const tm = telemetry(data)
+        if (tm) {
+          const age = (null == tm.corrAge) ? '' : (Infinity == tm.corrAge) ? ' age >120s' : ` age <${tm.corrAge}s`
+          log(`${tm.time} ${tm.source} ${tm.fix} ${tm.carr} ${tm.hAcc.toFixed(3)} ${tm.lat.toFixed(9)} ${tm.lon.toFixed(9)} ${tm.hMSL.toFixed(4)}${age}`)
+          if (map && track && (tm.fix != 'No')) {
+            let pos = ol.proj.fromLonLat([tm.lon, tm.lat])
+            map.getView().setCenter(pos)
+            track.getGeometry().appendCoordinate(pos)
+            point.getGeometry().setCoordinates(pos)
+          }
+        }
+      } else if (typeof(data) == 'string') {
+        log(`${data}`, data.startsWith('Dropped') ? 'orange' : 'black')
+        //                     time        src     fix  car acc       lat          lon
+        const m = data.match(/^\d+:\d+:\d+ [\w-]+ (\S+) \w+ \d+\.\d+ (-?\d+\.\d+) (-?\d+\.\d+)/)
+        if (map && track && m) {
+          if (m[1] != "No") {
+            let pos = ol.proj.fromLonLat([Number(m[3]), Number(m[2])])
+            map.getView().setCenter(pos)
+            track.getGeometry().appendCoordinate(pos)
+            point.getGeometry().setCoordinates(pos)
+          }
+        }
+      }
+    })
+    message.addEventListener('keyup', ({ keyCode }) => {
+      if (connected && (keyCode === 13)) {
+        ws.send(message.value)
+      }
+    })
+    log(`Connecting to ${url} ...`, 'blue')
+  }